@@ -0,0 +1,491 @@
+// Synthetic registration CSVs for load-testing the tournament engine in "Task 1 Simulation.cpp".
+// Build: g++ -std=c++17 -O2 -pthread "Player CSV Generator.cpp" -o "Player CSV Generator"
+// Usage: "Player CSV Generator" <output.csv> [options]
+//   --rows <n>                               (rows after the header, default 1000000)
+//   --schema registration|players|ranks      (columns of updated_player_info.csv, player_info.csv
+//                                             or player_ranks_full_names.csv; default registration)
+//   --mix <early>,<regular>,<wildcard>       (tier weights, default 16,42,6 as in the championship)
+//   --malformed <rate>                       (fraction of rows replaced by a malformed line)
+//   --duplicates <rate>                      (fraction of rows reusing an earlier row's player ID)
+//   --edge-ranks <rate>                      (fraction of rows with an edge-case rank)
+//   --seed <n>                               (default 1)
+//   --threads <n>                            (formatting threads, default: all cores)
+// Then load it, e.g.: "Task 1 Simulation" --players big.csv --max-players 1000000 --host 1
+//
+// Rows are ranked 1..n in file order with the tiers in rank order, like the fixtures. Every row
+// depends only on (seed, row number), so the output is identical for any thread count. Worker
+// threads format blocks of rows into large buffers and the main thread writes them in order.
+#define TOURNAMENT_NO_MAIN
+#include "Task 1 Simulation.cpp"
+
+#include <chrono>
+
+// --- Generator settings ---
+enum class CsvSchema { Registration, Players, Ranks };
+
+struct GeneratorSettings {
+    string outputPath;
+    long long rows;
+    CsvSchema schema;
+    double tierWeights[3]; // Early birds, regulars, wildcards
+    double malformedRate;
+    double duplicateRate;
+    double edgeRankRate;
+    unsigned long long seed;
+    int threads;
+
+    GeneratorSettings() : rows(1000000), schema(CsvSchema::Registration), malformedRate(0.0), duplicateRate(0.0),
+                          edgeRankRate(0.0), seed(1), threads(static_cast<int>(thread::hardware_concurrency())) {
+        tierWeights[0] = 16;
+        tierWeights[1] = 42;
+        tierWeights[2] = 6;
+    }
+};
+
+// What was injected, summed over the blocks.
+struct InjectionCounts {
+    long long malformed;
+    long long duplicates;
+    long long edgeRanks;
+};
+
+// --- Row synthesis ---
+const char* const FIRST_NAMES[] = {
+    "Jasnah", "Egwene", "Levi", "Kaladin", "Cirilla", "Jaskier", "Gandalf", "Renarin", "Matrim", "Erwin",
+    "Steris", "Elend", "Frodo", "Rand", "Nynaeve", "Eivor", "Garrus", "Shallan", "Ezio", "Bayek",
+    "Marasi", "Yennefer", "Thomdril", "Kelsier", "Geralt", "Navani", "Dalinar", "Aragorn", "Liara", "Aloy",
+    "Moiraine", "Roronoa", "Boromir", "Waxillium", "Vin", "Perrin", "Sazed", "Legolas", "Nami", "Mikasa",
+    "Adolin", "Christian", "Guled", "Mohammed", "Atreus", "Wayne", "Hoid", "Lift"
+};
+const char* const LAST_NAMES[] = {
+    "Kholin", "al'Vere", "Ackerman", "Stormblessed", "Fiona", "Dandelion", "the Grey", "Cauthon", "Smith", "Harms",
+    "Venture", "Baggins", "al'Thor", "al'Meara", "Varinsdottir", "Vakarian", "Davar", "Auditore", "of Siwa", "Colms",
+    "of Vengerberg", "Merrilin", "of Rivia", "son of Arathorn", "T'Soni", "of the Nora", "Damodred", "Zoro",
+    "of Gondor", "Ladrian", "Aybara", "Greenleaf", "Teo Li Xi", "Ibrahim", "Zawia", "Edgedancer"
+};
+const int NUM_FIRST_NAMES = sizeof(FIRST_NAMES) / sizeof(FIRST_NAMES[0]);
+const int NUM_LAST_NAMES = sizeof(LAST_NAMES) / sizeof(LAST_NAMES[0]);
+const char* const TIER_NAMES[3] = {"early birds", "regular", "wildcard"};
+
+const long long BLOCK_ROWS = 1 << 16;
+const size_t MAX_ROW_BYTES = 160; // Longest row any schema or injected fault can produce
+
+// splitmix64: the per-row random stream (row number and purpose mixed into the key)
+unsigned long long mixRow(unsigned long long key) {
+    unsigned long long z = key + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform in [0, 1) for row `row` and purpose `stream`.
+double rowChance(unsigned long long seed, long long row, int stream) {
+    return static_cast<double>(mixRow(seed ^ (static_cast<unsigned long long>(row) * 8 + stream)) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Appends to a block buffer without bounds checks (MAX_ROW_BYTES per row is reserved).
+class RowWriter {
+private:
+    char* cursor;
+
+public:
+    explicit RowWriter(char* start) : cursor(start) {}
+
+    char* position() const { return cursor; }
+
+    void text(const char* value) {
+        while (*value != '\0') {
+            *cursor++ = *value++;
+        }
+    }
+    void character(char value) {
+        *cursor++ = value;
+    }
+    void number(long long value) {
+        char digits[24];
+        int count = 0;
+        unsigned long long magnitude = (value < 0) ? 0ULL - static_cast<unsigned long long>(value)
+                                                   : static_cast<unsigned long long>(value);
+        do {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0) {
+            *cursor++ = '-';
+        }
+        while (count > 0) {
+            *cursor++ = digits[--count];
+        }
+    }
+    void paddedNumber(long long value, int width) { // Zero-padded, like PL001
+        char digits[24];
+        int count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        for (int i = count; i < width; ++i) {
+            *cursor++ = '0';
+        }
+        while (count > 0) {
+            *cursor++ = digits[--count];
+        }
+    }
+};
+
+class RowGenerator {
+private:
+    const GeneratorSettings& settings;
+    int idWidth;
+    long long earlyEnd;   // Ranks [1, earlyEnd] are early birds
+    long long regularEnd; // then regulars up to regularEnd, then wildcards
+
+    void playerId(RowWriter& out, long long row) const {
+        out.text("PL");
+        out.paddedNumber(row + 1, idWidth);
+    }
+
+    void fullName(RowWriter& out, long long row) const {
+        unsigned long long pick = mixRow(settings.seed ^ (static_cast<unsigned long long>(row) * 8 + 7));
+        out.text(FIRST_NAMES[pick % NUM_FIRST_NAMES]);
+        out.character(' ');
+        out.text(LAST_NAMES[(pick >> 20) % NUM_LAST_NAMES]);
+    }
+
+    int tierOf(long long rank) const {
+        return (rank <= earlyEnd) ? 0 : (rank <= regularEnd) ? 1 : 2;
+    }
+
+    // Rank field: the row's rank, or (when injected) a value the loader must cope with.
+    bool rank(RowWriter& out, long long row) const {
+        long long ranked = row + 1;
+        if (rowChance(settings.seed, row, 2) >= settings.edgeRankRate) {
+            out.number(ranked);
+            return false;
+        }
+        switch (mixRow(settings.seed ^ (static_cast<unsigned long long>(row) * 8 + 3)) % 8) {
+            case 0: out.number(0); break;
+            case 1: out.number(-1); break;
+            case 2: out.number(-ranked); break;
+            case 3: out.number(2147483647LL); break;                 // INT_MAX
+            case 4: out.number(2147483648LL); break;                 // Out of int range
+            case 5: out.number(ranked > 1 ? ranked - 1 : 1); break;  // Tie with the previous row
+            case 6: out.text("  "); out.number(ranked); break;       // Leading spaces
+            default: out.text("00"); out.number(ranked); break;      // Leading zeros
+        }
+        return true;
+    }
+
+    void malformedRow(RowWriter& out, long long row) const {
+        switch (mixRow(settings.seed ^ (static_cast<unsigned long long>(row) * 8 + 4)) % 6) {
+            case 0: // Missing columns
+                playerId(out, row);
+                out.character(',');
+                fullName(out, row);
+                break;
+            case 1: // Non-numeric rank
+                playerId(out, row);
+                out.character(',');
+                fullName(out, row);
+                out.text(",rank?,regular");
+                break;
+            case 2: // Wrong delimiter
+                playerId(out, row);
+                out.character(';');
+                fullName(out, row);
+                out.character(';');
+                out.number(row + 1);
+                break;
+            case 3: // Extra column
+                playerId(out, row);
+                out.character(',');
+                fullName(out, row);
+                out.character(',');
+                out.number(row + 1);
+                out.text(",regular,EXTRA");
+                break;
+            case 4: // Whitespace only
+                out.text("   ");
+                break;
+            default: // Empty line
+                break;
+        }
+        out.character('\n');
+    }
+
+public:
+    explicit RowGenerator(const GeneratorSettings& generatorSettings) : settings(generatorSettings), idWidth(3) {
+        for (long long limit = 1000; limit <= settings.rows; limit *= 10) {
+            idWidth++;
+        }
+        double total = settings.tierWeights[0] + settings.tierWeights[1] + settings.tierWeights[2];
+        earlyEnd = static_cast<long long>(settings.rows * (settings.tierWeights[0] / total));
+        regularEnd = static_cast<long long>(settings.rows * ((settings.tierWeights[0] + settings.tierWeights[1]) / total));
+    }
+
+    void header(RowWriter& out) const {
+        switch (settings.schema) {
+            case CsvSchema::Registration: out.text("player_id,player_name,ranking,registration type\n"); break;
+            case CsvSchema::Players: out.text("player_id,player_name,ranking\n"); break;
+            case CsvSchema::Ranks: out.text("full name,player name,rank\n"); break;
+        }
+    }
+
+    // Formats row `row` (0-based, after the header) and tallies what was injected.
+    void row(RowWriter& out, long long row, InjectionCounts& counts) const {
+        if (rowChance(settings.seed, row, 0) < settings.malformedRate) {
+            malformedRow(out, row);
+            counts.malformed++;
+            return;
+        }
+        if (settings.schema == CsvSchema::Ranks) { // Full name, short name, rank
+            fullName(out, row);
+            out.character(',');
+            out.text(FIRST_NAMES[mixRow(settings.seed ^ (static_cast<unsigned long long>(row) * 8 + 7)) % NUM_FIRST_NAMES]);
+            out.character(',');
+            counts.edgeRanks += rank(out, row) ? 1 : 0;
+            out.character('\n');
+            return;
+        }
+
+        long long idRow = row;
+        if (row > 0 && rowChance(settings.seed, row, 1) < settings.duplicateRate) {
+            long long window = (row < 1000) ? row : 1000; // A recent row, as a double registration would be
+            idRow = row - 1 - static_cast<long long>(mixRow(settings.seed ^ (static_cast<unsigned long long>(row) * 8 + 5)) % window);
+            counts.duplicates++;
+        }
+        playerId(out, idRow);
+        out.character(',');
+        fullName(out, row);
+        out.character(',');
+        counts.edgeRanks += rank(out, row) ? 1 : 0;
+        if (settings.schema == CsvSchema::Registration) {
+            out.character(',');
+            out.text(TIER_NAMES[tierOf(row + 1)]);
+        }
+        out.character('\n');
+    }
+};
+
+// --- Block pipeline ---
+// Block b is formatted into slot b % numSlots by whichever worker claims it, and written by the
+// main thread strictly in block order; a worker waits for its slot until block b - numSlots
+// has been written.
+class BlockWriter {
+private:
+    struct Slot {
+        char* data;
+        size_t length;
+        bool ready;
+    };
+
+    const RowGenerator& generator;
+    long long rows;
+    long long numBlocks;
+    int numSlots;
+    Slot* slots;
+    atomic<long long> nextBlock;
+    long long writtenBlocks;
+    mutex lock;
+    condition_variable changed;
+    InjectionCounts totals;
+
+    void formatBlocks() {
+        InjectionCounts counts = {0, 0, 0};
+        for (;;) {
+            long long block = nextBlock.fetch_add(1);
+            if (block >= numBlocks) {
+                break;
+            }
+            Slot& slot = slots[block % numSlots];
+            {
+                unique_lock<mutex> guard(lock);
+                changed.wait(guard, [&] { return block < writtenBlocks + numSlots; });
+            }
+            RowWriter out(slot.data);
+            long long end = (block + 1) * BLOCK_ROWS < rows ? (block + 1) * BLOCK_ROWS : rows;
+            for (long long row = block * BLOCK_ROWS; row < end; ++row) {
+                generator.row(out, row, counts);
+            }
+            {
+                lock_guard<mutex> guard(lock);
+                slot.length = static_cast<size_t>(out.position() - slot.data);
+                slot.ready = true;
+            }
+            changed.notify_all();
+        }
+        lock_guard<mutex> guard(lock);
+        totals.malformed += counts.malformed;
+        totals.duplicates += counts.duplicates;
+        totals.edgeRanks += counts.edgeRanks;
+    }
+
+public:
+    BlockWriter(const RowGenerator& rowGenerator, long long rowCount, int threads) :
+        generator(rowGenerator), rows(rowCount), numBlocks((rowCount + BLOCK_ROWS - 1) / BLOCK_ROWS),
+        numSlots(2 * threads), slots(new Slot[2 * threads]), nextBlock(0), writtenBlocks(0) {
+        for (int i = 0; i < numSlots; ++i) {
+            slots[i].data = new char[BLOCK_ROWS * MAX_ROW_BYTES];
+            slots[i].length = 0;
+            slots[i].ready = false;
+        }
+        totals.malformed = totals.duplicates = totals.edgeRanks = 0;
+    }
+
+    ~BlockWriter() {
+        for (int i = 0; i < numSlots; ++i) {
+            delete[] slots[i].data;
+        }
+        delete[] slots;
+    }
+
+    BlockWriter(const BlockWriter&) = delete;
+    BlockWriter& operator=(const BlockWriter&) = delete;
+
+    // Writes every row to `file`; returns the bytes written, or -1 on a write error.
+    long long run(FILE* file, int threads) {
+        thread* workers = new thread[threads];
+        for (int t = 0; t < threads; ++t) {
+            workers[t] = thread(&BlockWriter::formatBlocks, this);
+        }
+        long long bytes = 0;
+        bool failed = false;
+        for (long long block = 0; block < numBlocks; ++block) {
+            Slot& slot = slots[block % numSlots];
+            {
+                unique_lock<mutex> guard(lock);
+                changed.wait(guard, [&] { return slot.ready; });
+            }
+            if (!failed && fwrite(slot.data, 1, slot.length, file) != slot.length) {
+                failed = true; // Keep draining so the workers can finish
+            }
+            bytes += static_cast<long long>(slot.length);
+            {
+                lock_guard<mutex> guard(lock);
+                slot.ready = false;
+                writtenBlocks++;
+            }
+            changed.notify_all();
+        }
+        for (int t = 0; t < threads; ++t) {
+            workers[t].join();
+        }
+        delete[] workers;
+        return failed ? -1 : bytes;
+    }
+
+    const InjectionCounts& getInjected() const { return totals; }
+};
+
+// --- Command line ---
+bool parseRate(const char* text, const char* option, double& rate) {
+    rate = atof(text);
+    if (rate < 0.0 || rate > 1.0) {
+        cerr << "Error: " << option << " must be between 0 and 1." << endl;
+        return false;
+    }
+    return true;
+}
+
+bool parseSettings(int argc, char* argv[], GeneratorSettings& settings) {
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (option == "--rows" && hasValue) {
+            settings.rows = atoll(argv[++i]);
+            if (settings.rows < 0) {
+                cerr << "Error: --rows must not be negative." << endl;
+                return false;
+            }
+        } else if (option == "--schema" && hasValue) {
+            string schema = argv[++i];
+            if (schema == "registration") settings.schema = CsvSchema::Registration;
+            else if (schema == "players") settings.schema = CsvSchema::Players;
+            else if (schema == "ranks") settings.schema = CsvSchema::Ranks;
+            else {
+                cerr << "Error: Unknown schema '" << schema << "' (registration, players or ranks)." << endl;
+                return false;
+            }
+        } else if (option == "--mix" && hasValue) {
+            string mix = argv[++i];
+            stringstream parts(mix);
+            string part;
+            int count = 0;
+            while (getline(parts, part, ',') && count < 3) {
+                settings.tierWeights[count++] = atof(part.c_str());
+            }
+            if (count != 3 || settings.tierWeights[0] < 0 || settings.tierWeights[1] < 0 || settings.tierWeights[2] < 0
+                || settings.tierWeights[0] + settings.tierWeights[1] + settings.tierWeights[2] <= 0) {
+                cerr << "Error: --mix takes three non-negative weights, e.g. 16,42,6." << endl;
+                return false;
+            }
+        } else if (option == "--malformed" && hasValue) {
+            if (!parseRate(argv[++i], "--malformed", settings.malformedRate)) return false;
+        } else if (option == "--duplicates" && hasValue) {
+            if (!parseRate(argv[++i], "--duplicates", settings.duplicateRate)) return false;
+        } else if (option == "--edge-ranks" && hasValue) {
+            if (!parseRate(argv[++i], "--edge-ranks", settings.edgeRankRate)) return false;
+        } else if (option == "--seed" && hasValue) {
+            settings.seed = strtoull(argv[++i], nullptr, 10);
+        } else if (option == "--threads" && hasValue) {
+            settings.threads = atoi(argv[++i]);
+        } else if (option.size() > 2 && option.compare(0, 2, "--") == 0) {
+            cerr << "Error: Unknown option '" << option << "'." << endl;
+            return false;
+        } else if (settings.outputPath.empty()) {
+            settings.outputPath = option;
+        } else {
+            cerr << "Error: More than one output file given." << endl;
+            return false;
+        }
+    }
+    if (settings.outputPath.empty()) {
+        cerr << "Usage: \"Player CSV Generator\" <output.csv> [--rows n] [--schema registration|players|ranks]\n"
+             << "       [--mix early,regular,wildcard] [--malformed rate] [--duplicates rate] [--edge-ranks rate]\n"
+             << "       [--seed n] [--threads n]" << endl;
+        return false;
+    }
+    if (settings.threads < 1) {
+        settings.threads = 1;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    GeneratorSettings settings;
+    if (!parseSettings(argc, argv, settings)) {
+        return 1;
+    }
+
+    FILE* file = fopen(settings.outputPath.c_str(), "wb");
+    if (file == nullptr) {
+        cerr << "Error: Unable to create " << settings.outputPath << "." << endl;
+        return 1;
+    }
+    setvbuf(file, nullptr, _IONBF, 0); // Blocks are already large; skip the extra copy
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    RowGenerator generator(settings);
+    char header[MAX_ROW_BYTES];
+    RowWriter headerOut(header);
+    generator.header(headerOut);
+    size_t headerBytes = static_cast<size_t>(headerOut.position() - header);
+    long long bytes = (fwrite(header, 1, headerBytes, file) == headerBytes) ? static_cast<long long>(headerBytes) : -1;
+
+    BlockWriter writer(generator, settings.rows, settings.threads);
+    long long rowBytes = (bytes >= 0) ? writer.run(file, settings.threads) : -1;
+    if (fclose(file) != 0 || bytes < 0 || rowBytes < 0) {
+        cerr << "Error: Failed writing " << settings.outputPath << "." << endl;
+        return 1;
+    }
+    bytes += rowBytes;
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const InjectionCounts& injected = writer.getInjected();
+    cout << "Wrote " << settings.rows << " rows (" << bytes / (1024.0 * 1024.0) << " MiB) to " << settings.outputPath
+         << " in " << seconds << " s with " << settings.threads << " threads ("
+         << (seconds > 0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0) << " MiB/s)." << endl;
+    cout << "Injected: " << injected.malformed << " malformed lines, " << injected.duplicates << " duplicate IDs, "
+         << injected.edgeRanks << " edge-case ranks." << endl;
+    return 0;
+}
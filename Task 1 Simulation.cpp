@@ -4,19 +4,669 @@
 #include <limits>    // For numeric_limits
 #include <fstream>   // For file operations (CSV)
 #include <sstream>   // For parsing CSV lines
-#include <cstdlib>   // For rand(), srand()
+#include <iterator>  // For istreambuf_iterator, forward_iterator_tag
 #include <ctime>     // For time()
-
+#include <utility>   // For std::move, std::swap
+#include <new>       // Placement new (RingBufferQueue)
+#include <thread>    // Parallel group simulation
+#include <mutex>
+#include <condition_variable>
+#include <atomic>    // Lock-free queues for the pipelined bracket
+#include <cstdint>   // For intptr_t
+#include <cstring>   // For memcpy
+#include <cstddef>   // For offsetof
+#include <cstdio>    // For remove(), rename()
+#include <cstdlib>   // For atoi
+#include <functional> // Tasks for the tournament host's thread pool
+#include <chrono>    // Per-tournament latency
+#include <cmath>     // For pow, exp, sqrt (ratings)
+#ifdef _WIN32        // Durable writes and read-only mapping of the match history file
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>      // For _commit
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>  // For fsync
+#endif
+
+// Cache prefetch hint for scans that read scattered entries (does nothing where unsupported)
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)(address))
+#endif
 
 using namespace std;
 
+// --- Metrics ---
+// Phase and round timers plus hot-path counters, compiled in only with -DTOURNAMENT_METRICS.
+// Without it every METRICS_* macro expands to nothing, so a normal build counts and times
+// nothing. Each thread counts into its own cache-line block (single writer, relaxed atomics,
+// no lock); blocks outlive their threads and are summed only when the report is written.
+// Timings are recorded under a lock, once per phase or round. Rounds are totalled per stage
+// and round number (count, sum, max), so the many events of a --host run share one entry per
+// round instead of repeating it. main writes the report (--metrics).
+#ifdef TOURNAMENT_METRICS
+enum class MetricCounter {
+    MatchesRecorded,  // GameResultLogger::recordMatchOutcome
+    HeapAllocations,  // Global operator new (simulation executable only)
+    QueueOperations,  // Enqueues/dequeues and pushes/pops on the queue and stack classes
+    ScanSteps,        // Nodes visited by PlayerQueue searches, slots probed by PlayerIdIndex
+    StatsLookups,     // GameResultLogger::findPlayerStatsInArray
+    NumCounters
+};
+
+class TournamentMetrics {
+public:
+    static const int NUM_COUNTERS = static_cast<int>(MetricCounter::NumCounters);
+
+    static void add(MetricCounter counter, long long amount) {
+        ThreadCounters* block = localCounters;
+        if (block == nullptr) {
+            block = localCounters = registerThread();
+        }
+        atomic<long long>& value = block->values[static_cast<int>(counter)];
+        value.store(value.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+
+    // Ends the current phase (if any) and starts timing `name`. Phases run on the main thread.
+    static void enterPhase(const char* name) {
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        lock_guard<mutex> lock(registryLock);
+        closePhaseLocked(now);
+        currentPhase = name;
+        phaseStart = now;
+    }
+
+    static void endPhase() {
+        chrono::steady_clock::time_point now = chrono::steady_clock::now();
+        lock_guard<mutex> lock(registryLock);
+        closePhaseLocked(now);
+    }
+
+    // Times one round of `stage` from construction to the end of the enclosing scope.
+    class ScopedRound {
+    public:
+        ScopedRound(const char* stage, int round)
+            : stage(stage), round(round), start(chrono::steady_clock::now()) {}
+        ~ScopedRound() {
+            chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+            recordRound(stage, round, elapsed.count());
+        }
+        ScopedRound(const ScopedRound&) = delete;
+        ScopedRound& operator=(const ScopedRound&) = delete;
+
+    private:
+        const char* stage;
+        int round;
+        chrono::steady_clock::time_point start;
+    };
+
+    // Adds one timed round of `stage` (for rounds that overlap and cannot use ScopedRound).
+    static void recordRound(const char* stage, int round, double seconds) {
+        lock_guard<mutex> lock(registryLock);
+        RoundTotals* totals = firstRound;
+        while (totals != nullptr && (totals->round != round || strcmp(totals->stage, stage) != 0)) {
+            totals = totals->next;
+        }
+        if (totals == nullptr) {
+            totals = static_cast<RoundTotals*>(malloc(sizeof(RoundTotals)));
+            if (totals == nullptr) {
+                return;
+            }
+            *totals = RoundTotals{stage, round, 0, 0.0, 0.0, nullptr};
+            if (lastRound == nullptr) {
+                firstRound = totals;
+            }
+            else {
+                lastRound->next = totals;
+            }
+            lastRound = totals;
+        }
+        totals->count++;
+        totals->sumSeconds += seconds;
+        if (seconds > totals->maxSeconds) {
+            totals->maxSeconds = seconds;
+        }
+    }
+
+    // Ends the current phase and writes the report to `path` (if any) when it goes out of scope.
+    class ReportAtExit {
+    public:
+        ReportAtExit(const string& path, bool prometheus) : path(path), prometheus(prometheus) {}
+        ~ReportAtExit() {
+            endPhase();
+            if (!path.empty()) {
+                writeReport(path, prometheus);
+            }
+        }
+        ReportAtExit(const ReportAtExit&) = delete;
+        ReportAtExit& operator=(const ReportAtExit&) = delete;
+
+    private:
+        string path;
+        bool prometheus;
+    };
+
+    static bool writeReport(const string& path, bool prometheus) {
+        ofstream out(path.c_str());
+        if (!out) {
+            cerr << "Error: Could not open metrics report " << path << " for writing." << endl;
+            return false;
+        }
+        long long totals[NUM_COUNTERS];
+        int threadCount = sumCounters(totals);
+        lock_guard<mutex> lock(registryLock);
+        if (prometheus) {
+            writePrometheusLocked(out, totals, threadCount);
+        }
+        else {
+            writeJsonLocked(out, totals, threadCount);
+        }
+        return static_cast<bool>(out);
+    }
+
+private:
+    struct alignas(64) ThreadCounters {
+        atomic<long long> values[NUM_COUNTERS];
+        ThreadCounters* next;
+    };
+
+    struct PhaseSpan {
+        const char* name;
+        double seconds;
+        PhaseSpan* next;
+    };
+
+    struct RoundTotals {
+        const char* stage;
+        int round;
+        long long count;    // Times this round was played (once per event)
+        double sumSeconds;
+        double maxSeconds;
+        RoundTotals* next;
+    };
+
+    static inline mutex registryLock;
+    static inline ThreadCounters* threadBlocks = nullptr;
+    static inline ThreadCounters overflowBlock{};  // Shared fallback if a block cannot be allocated
+    static inline thread_local ThreadCounters* localCounters = nullptr;
+    static inline PhaseSpan* firstPhase = nullptr;
+    static inline PhaseSpan* lastPhase = nullptr;
+    static inline RoundTotals* firstRound = nullptr;  // In the order first seen
+    static inline RoundTotals* lastRound = nullptr;
+    static inline const char* currentPhase = nullptr;
+    static inline chrono::steady_clock::time_point phaseStart;
+
+    // Blocks come from malloc, not new, since operator new itself counts into them.
+    static ThreadCounters* registerThread() {
+        void* raw = malloc(sizeof(ThreadCounters) + alignof(ThreadCounters) - 1);
+        if (raw == nullptr) {
+            return &overflowBlock;
+        }
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + alignof(ThreadCounters) - 1)
+                            & ~static_cast<uintptr_t>(alignof(ThreadCounters) - 1);
+        ThreadCounters* block = new (reinterpret_cast<void*>(aligned)) ThreadCounters;
+        for (int i = 0; i < NUM_COUNTERS; ++i) {
+            block->values[i].store(0, memory_order_relaxed);
+        }
+        lock_guard<mutex> lock(registryLock);
+        block->next = threadBlocks;
+        threadBlocks = block;
+        return block;
+    }
+
+    // Totals across every thread block; returns how many threads counted anything.
+    static int sumCounters(long long totals[NUM_COUNTERS]) {
+        for (int i = 0; i < NUM_COUNTERS; ++i) {
+            totals[i] = overflowBlock.values[i].load(memory_order_relaxed);
+        }
+        lock_guard<mutex> lock(registryLock);
+        int threadCount = 0;
+        for (ThreadCounters* block = threadBlocks; block != nullptr; block = block->next) {
+            for (int i = 0; i < NUM_COUNTERS; ++i) {
+                totals[i] += block->values[i].load(memory_order_relaxed);
+            }
+            threadCount++;
+        }
+        return threadCount;
+    }
+
+    static void closePhaseLocked(chrono::steady_clock::time_point now) {
+        if (currentPhase == nullptr) {
+            return;
+        }
+        const char* phaseName = currentPhase;
+        chrono::duration<double> elapsed = now - phaseStart;
+        currentPhase = nullptr;
+        PhaseSpan* span = static_cast<PhaseSpan*>(malloc(sizeof(PhaseSpan)));
+        if (span == nullptr) {
+            return;
+        }
+        *span = PhaseSpan{phaseName, elapsed.count(), nullptr};
+        if (lastPhase == nullptr) {
+            firstPhase = span;
+        }
+        else {
+            lastPhase->next = span;
+        }
+        lastPhase = span;
+    }
+
+    static const char* counterName(int counter) {
+        static const char* const names[NUM_COUNTERS] = {
+            "matches_recorded", "heap_allocations", "queue_operations", "scan_steps", "stats_lookups"
+        };
+        return names[counter];
+    }
+
+    static const char* counterHelp(int counter) {
+        static const char* const help[NUM_COUNTERS] = {
+            "Matches recorded by the result logger.",
+            "Global operator new calls.",
+            "Enqueue, dequeue, push and pop operations on the queue and stack classes.",
+            "Nodes visited by PlayerQueue searches and slots probed by PlayerIdIndex.",
+            "Player stats lookups by ID."
+        };
+        return help[counter];
+    }
+
+    static void writeJsonLocked(ostream& out, const long long totals[NUM_COUNTERS], int threadCount) {
+        out << "{\n  \"threads\": " << threadCount << ",\n  \"counters\": {";
+        for (int i = 0; i < NUM_COUNTERS; ++i) {
+            out << (i == 0 ? "\n" : ",\n") << "    \"" << counterName(i) << "\": " << totals[i];
+        }
+        out << "\n  },\n  \"phases\": [";
+        bool first = true;
+        for (PhaseSpan* span = firstPhase; span != nullptr; span = span->next) {
+            out << (first ? "\n" : ",\n") << "    {\"name\": \"" << span->name
+                << "\", \"seconds\": " << span->seconds << "}";
+            first = false;
+        }
+        out << (first ? "]" : "\n  ]") << ",\n  \"rounds\": [";
+        first = true;
+        for (RoundTotals* totals = firstRound; totals != nullptr; totals = totals->next) {
+            out << (first ? "\n" : ",\n") << "    {\"stage\": \"" << totals->stage << "\", \"round\": "
+                << totals->round << ", \"count\": " << totals->count << ", \"seconds\": " << totals->sumSeconds
+                << ", \"max_seconds\": " << totals->maxSeconds << "}";
+            first = false;
+        }
+        out << (first ? "]" : "\n  ]") << "\n}\n";
+    }
+
+    static void writePrometheusLocked(ostream& out, const long long totals[NUM_COUNTERS], int threadCount) {
+        out << "# HELP tournament_phase_seconds Wall-clock time of each phase of the run.\n"
+            << "# TYPE tournament_phase_seconds gauge\n";
+        for (PhaseSpan* span = firstPhase; span != nullptr; span = span->next) {
+            out << "tournament_phase_seconds{phase=\"" << span->name << "\"} " << span->seconds << "\n";
+        }
+        out << "# HELP tournament_round_seconds Wall-clock time of each round, over every event that played it.\n"
+            << "# TYPE tournament_round_seconds summary\n";
+        for (RoundTotals* totals = firstRound; totals != nullptr; totals = totals->next) {
+            out << "tournament_round_seconds_sum{stage=\"" << totals->stage << "\",round=\"" << totals->round
+                << "\"} " << totals->sumSeconds << "\n"
+                << "tournament_round_seconds_count{stage=\"" << totals->stage << "\",round=\"" << totals->round
+                << "\"} " << totals->count << "\n";
+        }
+        out << "# HELP tournament_round_max_seconds Slowest play of each round.\n"
+            << "# TYPE tournament_round_max_seconds gauge\n";
+        for (RoundTotals* totals = firstRound; totals != nullptr; totals = totals->next) {
+            out << "tournament_round_max_seconds{stage=\"" << totals->stage << "\",round=\"" << totals->round
+                << "\"} " << totals->maxSeconds << "\n";
+        }
+        for (int i = 0; i < NUM_COUNTERS; ++i) {
+            out << "# HELP tournament_" << counterName(i) << "_total " << counterHelp(i) << "\n"
+                << "# TYPE tournament_" << counterName(i) << "_total counter\n"
+                << "tournament_" << counterName(i) << "_total " << totals[i] << "\n";
+        }
+        out << "# HELP tournament_metric_threads Threads that recorded counters.\n"
+            << "# TYPE tournament_metric_threads gauge\n"
+            << "tournament_metric_threads " << threadCount << "\n";
+    }
+};
+
+#define METRICS_ADD(counter, amount) TournamentMetrics::add(MetricCounter::counter, (amount))
+#define METRICS_PHASE(name) TournamentMetrics::enterPhase(name)
+#define METRICS_ROUND(stage, round) TournamentMetrics::ScopedRound metricsRound((stage), (round))
+
+#ifndef TOURNAMENT_NO_MAIN
+// Counts heap allocations (programs that include this file keep their own operator new).
+// Kept out of line so the compiler never pairs an inlined free() with a new-expression.
+#if defined(__GNUC__) || defined(__clang__)
+#define METRICS_NOINLINE __attribute__((noinline))
+#else
+#define METRICS_NOINLINE
+#endif
+METRICS_NOINLINE void* operator new(size_t size) {
+    METRICS_ADD(HeapAllocations, 1);
+    void* block = malloc(size > 0 ? size : 1);
+    if (block == nullptr) {
+        throw bad_alloc();
+    }
+    return block;
+}
+
+METRICS_NOINLINE void operator delete(void* block) noexcept {
+    free(block);
+}
+
+METRICS_NOINLINE void operator delete(void* block, size_t) noexcept {
+    free(block);
+}
+#endif
+#else
+#define METRICS_ADD(counter, amount) ((void)0)
+#define METRICS_PHASE(name) ((void)0)
+#define METRICS_ROUND(stage, round) ((void)0)
+#endif
+
+// --- Trace ---
+// Timeline of begin/end spans in the Chrome trace-event format (open in chrome://tracing or
+// Perfetto), compiled in only with -DTOURNAMENT_TRACE; otherwise the TRACE_* macros expand to
+// nothing. Each thread appends to its own fixed ring (no lock, no allocation after the first
+// span), keeping its newest events; the rings are written out only when main returns.
+#ifdef TOURNAMENT_TRACE
+class TournamentTrace {
+public:
+    static const int EVENTS_PER_THREAD = 1 << 16;
+
+    // Marks a span from construction to the end of the enclosing scope. `name` must be a
+    // string literal; a non-negative `index` is appended to it (e.g. the round number).
+    class ScopedSpan {
+    public:
+        explicit ScopedSpan(const char* name, int index = -1) : name(name), index(index) {
+            record(name, index, 'B');
+        }
+        ~ScopedSpan() {
+            record(name, index, 'E');
+        }
+        ScopedSpan(const ScopedSpan&) = delete;
+        ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+    private:
+        const char* name;
+        int index;
+    };
+
+    // Writes the trace to `path` when it goes out of scope (after every traced thread is done).
+    class WriteAtExit {
+    public:
+        explicit WriteAtExit(const string& path) : path(path) {}
+        ~WriteAtExit() {
+            if (write(path)) {
+                cerr << "Trace written to " << path << "." << endl;
+            }
+        }
+        WriteAtExit(const WriteAtExit&) = delete;
+        WriteAtExit& operator=(const WriteAtExit&) = delete;
+
+    private:
+        string path;
+    };
+
+    static bool write(const string& path) {
+        ofstream out(path.c_str());
+        if (!out) {
+            cerr << "Error: Could not open trace file " << path << " for writing." << endl;
+            return false;
+        }
+        lock_guard<mutex> lock(registryLock);
+        long long origin = 0; // Earliest kept event, so timestamps start near zero
+        bool haveOrigin = false;
+        long long dropped = 0;
+        for (ThreadTrace* trace = threadTraces; trace != nullptr; trace = trace->next) {
+            long long kept = trace->written < EVENTS_PER_THREAD ? trace->written : EVENTS_PER_THREAD;
+            dropped += trace->written - kept;
+            if (kept > 0) {
+                long long first = trace->events[(trace->written - kept) % EVENTS_PER_THREAD].nanoseconds;
+                if (!haveOrigin || first < origin) {
+                    origin = first;
+                    haveOrigin = true;
+                }
+            }
+        }
+
+        out << "{\"traceEvents\": [";
+        bool firstEvent = true;
+        out.setf(ios::fixed);
+        out.precision(3);
+        for (ThreadTrace* trace = threadTraces; trace != nullptr; trace = trace->next) {
+            long long kept = trace->written < EVENTS_PER_THREAD ? trace->written : EVENTS_PER_THREAD;
+            int depth = 0;
+            for (long long i = trace->written - kept; i < trace->written; ++i) {
+                const TraceEvent& event = trace->events[i % EVENTS_PER_THREAD];
+                if (event.phase == 'E') {
+                    if (depth == 0) {
+                        continue; // Its begin was overwritten
+                    }
+                    depth--;
+                }
+                else {
+                    depth++;
+                }
+                out << (firstEvent ? "\n" : ",\n") << "  {\"name\": \"" << event.name;
+                if (event.index >= 0) {
+                    out << " " << event.index;
+                }
+                out << "\", \"cat\": \"tournament\", \"ph\": \"" << event.phase << "\", \"ts\": "
+                    << (event.nanoseconds - origin) / 1000.0 << ", \"pid\": 1, \"tid\": " << trace->threadId << "}";
+                firstEvent = false;
+            }
+        }
+        out << (firstEvent ? "]" : "\n]") << ",\n\"displayTimeUnit\": \"ms\",\n"
+            << "\"otherData\": {\"droppedEvents\": " << dropped << "}}\n";
+        return static_cast<bool>(out);
+    }
+
+private:
+    struct TraceEvent {
+        const char* name;
+        int index;
+        char phase;             // 'B' or 'E'
+        long long nanoseconds;  // steady_clock
+    };
+
+    struct ThreadTrace {
+        TraceEvent* events;     // Ring of EVENTS_PER_THREAD; only the owning thread writes
+        long long written;      // Events ever recorded (the ring keeps the newest)
+        int threadId;           // 1 for the first thread that traced anything, and so on
+        ThreadTrace* next;
+    };
+
+    static inline mutex registryLock;
+    static inline ThreadTrace* threadTraces = nullptr;
+    static inline int numThreads = 0;
+    static inline thread_local ThreadTrace* localTrace = nullptr;
+
+    static ThreadTrace* registerThread() {
+        ThreadTrace* trace = new ThreadTrace;
+        trace->events = new TraceEvent[EVENTS_PER_THREAD];
+        trace->written = 0;
+        lock_guard<mutex> lock(registryLock);
+        trace->threadId = ++numThreads;
+        trace->next = threadTraces;
+        threadTraces = trace;
+        return trace;
+    }
+
+    static void record(const char* name, int index, char phase) {
+        long long now = chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+        ThreadTrace* trace = localTrace;
+        if (trace == nullptr) {
+            trace = localTrace = registerThread();
+        }
+        trace->events[trace->written % EVENTS_PER_THREAD] = TraceEvent{name, index, phase, now};
+        trace->written++;
+    }
+};
+
+#define TRACE_SPAN(name) TournamentTrace::ScopedSpan traceSpan(name)
+#define TRACE_SPAN_INDEX(name, index) TournamentTrace::ScopedSpan traceSpan((name), (index))
+#else
+#define TRACE_SPAN(name) ((void)0)
+#define TRACE_SPAN_INDEX(name, index) ((void)0)
+#endif
+
 // Global constant for maximum players, consistent across modules.
-const int MAX_PLAYERS_UNIVERSAL = 64; 
+const int MAX_PLAYERS_UNIVERSAL = 64;
+
+// --- PlayerIdCodec ---
+// Player IDs as 64-bit keys, so telling two players apart is one integer compare instead of
+// a string compare. An ID of up to 10 characters from [0-9A-Za-z_] (every ID the CSVs use,
+// e.g. "PL001") is packed 6 bits per character, first character in the low bits. Any other
+// ID is interned in a process-wide table and keyed by its index with the top bit set.
+// The empty ID is key 0. The text form (Player::playerId) stays for printing and saving.
+typedef unsigned long long PlayerKey;
+
+class PlayerIdCodec {
+public:
+    static const int MAX_PACKED_CHARS = 10;
+    static const PlayerKey INTERNED_BIT = 1ULL << 63;
+
+    // Key of `id`, interning it if it cannot be packed.
+    static PlayerKey encode(const string& id) {
+        PlayerKey key;
+        if (pack(id, key)) return key;
+        return INTERNED_BIT | static_cast<PlayerKey>(table().intern(id));
+    }
+
+    // Key of `id` without interning it. False if `id` cannot be packed and was never interned,
+    // i.e. no player has it -- for lookups by typed-in IDs, which must not grow the table.
+    static bool lookup(const string& id, PlayerKey& key) {
+        if (pack(id, key)) return true;
+        int index = table().find(id);
+        if (index < 0) return false;
+        key = INTERNED_BIT | static_cast<PlayerKey>(index);
+        return true;
+    }
+
+private:
+    // 1..63 for packable characters, 0 otherwise.
+    static int symbolOf(char c) {
+        if (c >= '0' && c <= '9') return 1 + (c - '0');
+        if (c >= 'A' && c <= 'Z') return 11 + (c - 'A');
+        if (c >= 'a' && c <= 'z') return 37 + (c - 'a');
+        if (c == '_') return 63;
+        return 0;
+    }
+    static bool pack(const string& id, PlayerKey& key) {
+        if (id.size() > static_cast<size_t>(MAX_PACKED_CHARS)) return false;
+        key = 0;
+        for (size_t i = 0; i < id.size(); ++i) {
+            int symbol = symbolOf(id[i]);
+            if (symbol == 0) return false;
+            key |= static_cast<PlayerKey>(symbol) << (6 * i);
+        }
+        return true;
+    }
+
+    // Non-conforming IDs in an open-addressing table of immutable entries. The table is
+    // process-wide because keys are: a Player's idKey is compared against keys held by other
+    // events, loggers and history readers, so the same ID must map to one key everywhere. It
+    // only grows, by one entry per distinct non-packable ID -- no more than the Players
+    // carrying those IDs already hold.
+    // Interning takes the lock; find() does not. Writers fill a slot only after its entry is
+    // built and publish a rebuilt slot array only after it is filled, so a reader sees either
+    // a complete entry or an empty slot. Replaced slot arrays stay allocated (they total less
+    // than the live one) because a reader may still be probing them.
+    class InternTable {
+    private:
+        struct Entry {
+            string id;
+            int index;
+        };
+        struct SlotArray {
+            int slotCount;                 // Power of two, kept at most half full
+            atomic<const Entry*>* slots;   // nullptr = empty
+            SlotArray* replaced;           // The array this one replaced
+        };
+
+        mutex lock; // Serializes intern()
+        atomic<SlotArray*> current;
+        int count;
+
+        static size_t hashOf(const string& id) { return hash<string>()(id); }
+
+        static SlotArray* newSlotArray(int slotCount, SlotArray* replaced) {
+            SlotArray* array = new SlotArray;
+            array->slotCount = slotCount;
+            array->slots = new atomic<const Entry*>[slotCount];
+            for (int i = 0; i < slotCount; ++i) array->slots[i].store(nullptr, memory_order_relaxed);
+            array->replaced = replaced;
+            return array;
+        }
+
+        static void place(SlotArray* array, const Entry* entry) {
+            size_t mask = static_cast<size_t>(array->slotCount - 1);
+            size_t pos = hashOf(entry->id) & mask;
+            while (array->slots[pos].load(memory_order_relaxed) != nullptr) pos = (pos + 1) & mask;
+            array->slots[pos].store(entry, memory_order_release);
+        }
+
+        static int findIn(const SlotArray* array, const string& id) {
+            size_t mask = static_cast<size_t>(array->slotCount - 1);
+            for (size_t pos = hashOf(id) & mask;; pos = (pos + 1) & mask) {
+                const Entry* entry = array->slots[pos].load(memory_order_acquire);
+                if (entry == nullptr) return -1;
+                if (entry->id == id) return entry->index;
+            }
+        }
+
+        // Rehashes every entry into a table twice the size, then publishes it.
+        void growLocked() {
+            SlotArray* old = current.load(memory_order_relaxed);
+            SlotArray* grown = newSlotArray(old->slotCount * 2, old);
+            for (int i = 0; i < old->slotCount; ++i) {
+                const Entry* entry = old->slots[i].load(memory_order_relaxed);
+                if (entry != nullptr) place(grown, entry);
+            }
+            current.store(grown, memory_order_release);
+        }
+
+    public:
+        InternTable() : current(newSlotArray(32, nullptr)), count(0) {}
+        ~InternTable() {
+            SlotArray* array = current.load(memory_order_relaxed);
+            for (int i = 0; i < array->slotCount; ++i) delete array->slots[i].load(memory_order_relaxed);
+            while (array != nullptr) {
+                SlotArray* replaced = array->replaced;
+                delete[] array->slots;
+                delete array;
+                array = replaced;
+            }
+        }
+        InternTable(const InternTable&) = delete;
+        InternTable& operator=(const InternTable&) = delete;
+
+        int intern(const string& id) {
+            lock_guard<mutex> guard(lock);
+            int index = findIn(current.load(memory_order_relaxed), id);
+            if (index >= 0) return index;
+            if (2 * (count + 1) > current.load(memory_order_relaxed)->slotCount) growLocked();
+            place(current.load(memory_order_relaxed), new Entry{id, count});
+            return count++;
+        }
+
+        int find(const string& id) const {
+            return findIn(current.load(memory_order_acquire), id);
+        }
+    };
+
+    static InternTable& table() {
+        static InternTable instance;
+        return instance;
+    }
+};
 
 // --- Player Struct (Consolidated from both systems) ---
 // This structure now includes fields for both tournament play and registration management.
 struct Player {
     string playerId; // Changed from int id to string
+    PlayerKey idKey; // PlayerIdCodec key of playerId; what comparisons use
     string playerName;
     int ranking;
     string registrationStatus; // Current status: "Early birds", "Regular", "Wildcard", "Checked In", "Withdrawn", "Replacement"
@@ -25,6 +675,7 @@ struct Player {
 
     Player() : 
         playerId(""), 
+        idKey(0),
         playerName(""), 
         ranking(0), 
         registrationStatus(""), 
@@ -36,19 +687,32 @@ struct Player {
     // or the "Replacement" status for replacement players.
     // `originalPriority` stores the original category (early birds/regular/wildcard).
     Player(string id, string name, int rank, string status = "regular", string time = ""): // Default status to "regular" (lowercase)
-        playerId(id), 
-        playerName(name), 
+        playerId(std::move(id)), 
+        idKey(PlayerIdCodec::encode(playerId)),
+        playerName(std::move(name)), 
         ranking(rank), 
-        registrationStatus(status), 
-        registrationTime(time)
+        registrationStatus(std::move(status)), 
+        registrationTime(std::move(time))
         {
             // For players loaded from CSV, originalPriority is the status read from CSV.
             // For replacement players, the 'status' parameter might be "Replacement",
             // but originalPriority should reflect their category based on rank.
             // The `addReplacementPlayer` function will correctly set this.
-            originalPriority = status; 
+            originalPriority = registrationStatus; 
         }
 
+    // Changes the ID, keeping idKey in step.
+    void setId(string id) {
+        playerId = std::move(id);
+        idKey = PlayerIdCodec::encode(playerId);
+    }
+
+    // Shared empty player (ID "") for lookups that return a reference and find no one.
+    static const Player& none() {
+        static const Player empty;
+        return empty;
+    }
+
     friend ostream& operator<<(ostream& os, const Player& p) {
         os << "ID: " << p.playerId << ", Name: " << p.playerName << ", Rank: " << p.ranking;
         return os;
@@ -59,9 +723,9 @@ struct Player {
     bool operator<(const Player& other) const {
         return ranking < other.ranking;
     }
-    // Equality based on Player ID (string)
+    // Equality based on Player ID (compared by key)
     bool operator==(const Player& other) const {
-        return playerId == other.playerId;
+        return idKey == other.idKey;
     }
     bool operator!=(const Player& other) const {
         return !(*this == other);
@@ -72,32 +736,74 @@ struct Player {
 // Sorts by numerical rank (lower is better)
 void insertionSortPlayers(Player arr[], int n) {
     for (int i = 1; i < n; ++i) {
-        Player key = arr[i];
+        if (arr[i - 1].ranking <= arr[i].ranking) {
+            continue; // Already in place (the common case for a seeded field)
+        }
+        Player key = std::move(arr[i]);
         int j = i - 1;
 
         while (j >= 0 && arr[j].ranking > key.ranking) { // Uses Player::ranking for comparison
-            arr[j + 1] = arr[j];
+            arr[j + 1] = std::move(arr[j]);
             j = j - 1;
         }
-        arr[j + 1] = key;
+        arr[j + 1] = std::move(key);
+    }
+}
+
+// Same order as insertionSortPlayers (both are stable), for fields of any size: insertion
+// sort is quadratic once a large field arrives shuffled, as a round's winners do. Runs of 32
+// are insertion sorted, then merged bottom-up through a scratch array; a merge whose halves
+// are already in order is skipped, so an already seeded field stays linear.
+void mergeSortPlayers(Player arr[], int n) {
+    const int RUN = 32;
+    for (int start = 0; start < n; start += RUN) {
+        insertionSortPlayers(arr + start, (n - start < RUN) ? n - start : RUN);
+    }
+    if (n <= RUN) {
+        return;
+    }
+    Player* scratch = new Player[n];
+    for (int width = RUN; width < n; width *= 2) {
+        for (int left = 0; left + width < n; left += 2 * width) {
+            int mid = left + width;
+            int right = (left + 2 * width < n) ? left + 2 * width : n;
+            if (arr[mid - 1].ranking <= arr[mid].ranking) {
+                continue; // Halves already in order
+            }
+            for (int k = left; k < mid; ++k) {
+                scratch[k] = std::move(arr[k]);
+            }
+            int i = left, j = mid, k = left; // k stays below j, so unread right-half players are never overwritten
+            while (i < mid && j < right) {
+                arr[k++] = (arr[j].ranking < scratch[i].ranking) ? std::move(arr[j++]) : std::move(scratch[i++]);
+            }
+            while (i < mid) {
+                arr[k++] = std::move(scratch[i++]);
+            }
+        }
     }
+    delete[] scratch;
 }
 
 
 // --- Match Struct (from original tournament system) ---
 struct Match {
-    static int nextMatchIdCounter; // Static counter for unique match IDs
-    int matchId;
+    int matchId;    // Assigned from the owning tournament's MatchIdSequence
     Player player1;
     Player player2;
     Player winner; // Winner player object
     bool played;   // Flag to indicate if the match has been played
+    int round;     // Round within its stage (1-based), 0 if unknown
+    int group;     // Group-stage group (1-based), 0 for bracket matches
 
-    Match(Player p1 = Player(), Player p2 = Player()) : player1(p1), player2(p2), played(false) {
-        matchId = nextMatchIdCounter++;
+    Match(Player p1 = Player(), Player p2 = Player(), int id = 0) : matchId(id), player1(std::move(p1)), player2(std::move(p2)), played(false), round(0), group(0) {
         // 'winner' is a default Player() (ID "", Name "", Rank 0) until determined
     }
 
+    // Creates an empty match with a given ID.
+    // Used by schedulers that keep one Match object and refill it for every game.
+    explicit Match(int id) : matchId(id), played(false), round(0), group(0) {}
+
     friend ostream& operator<<(ostream& os, const Match& m) {
         os << "Match ID: " << m.matchId << " | " << m.player1.playerName << " vs " << m.player2.playerName;
         if (m.played) {
@@ -113,7 +819,206 @@ struct Match {
     }
 };
 
-int Match::nextMatchIdCounter = 1; // Initialize static member for Match IDs
+// --- MatchIdSequence ---
+// Hands out match IDs (1, 2, 3, ...) for one tournament. Every tournament owns its own
+// sequence, so independent tournaments can be simulated side by side on different threads.
+class MatchIdSequence {
+private:
+    int nextId;
+
+public:
+    MatchIdSequence(int firstId = 1) : nextId(firstId) {}
+
+    int next() { return nextId++; }
+
+    // Reserves `count` consecutive IDs and returns the first one
+    int reserve(int count) {
+        int firstId = nextId;
+        nextId += count;
+        return firstId;
+    }
+
+    int peekNext() const { return nextId; }
+    void restore(int id) { nextId = id; } // Used when resuming from a checkpoint
+};
+
+// --- MatchOutcomeModel ---
+// Decides the winner of every simulated match. All scheduler modes share one instance
+// so a tournament is driven by a single seeded generator instead of the global rand().
+class MatchOutcomeModel {
+private:
+    unsigned long long rngState;
+
+    // xorshift64* step
+    unsigned long long nextRandom() {
+        rngState ^= rngState >> 12;
+        rngState ^= rngState << 25;
+        rngState ^= rngState >> 27;
+        return rngState * 2685821657736338717ULL;
+    }
+
+public:
+    MatchOutcomeModel(unsigned long long seed = 1) {
+        reseed(seed);
+    }
+
+    void reseed(unsigned long long seed) {
+        rngState = (seed != 0) ? seed : 0x9E3779B97F4A7C15ULL; // xorshift state must never be zero
+    }
+
+    // Raw generator state, saved in checkpoints (restore with reseed()).
+    unsigned long long getState() const {
+        return rngState;
+    }
+
+    // Draws a seed for an independent generator (e.g. one per group simulated on another thread)
+    unsigned long long nextSeed() {
+        return nextRandom();
+    }
+
+    // Simulate match outcome: RANDOMLY (50/50 chance for either player)
+    bool player1Wins() {
+        return (nextRandom() >> 63) == 0;
+    }
+
+    // Same 50/50 rule, but the result depends only on (streamSeed, matchId) (splitmix64 hash),
+    // so worker threads can resolve matches in any order and still match a single-threaded run.
+    static bool player1WinsMatch(unsigned long long streamSeed, int matchId) {
+        unsigned long long z = streamSeed + 0x9E3779B97F4A7C15ULL * static_cast<unsigned long long>(matchId + 1);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return (z >> 63) == 0;
+    }
+
+    // Fills in the winner of a match and marks it as played.
+    void resolve(Match& match) {
+        if (player1Wins()) {
+            match.winner = match.player1;
+        } else {
+            match.winner = match.player2;
+        }
+        match.played = true;
+    }
+};
+
+// --- SimulationLog ---
+// Output layer for the simulation phases. Text is collected in one large block and only
+// written out at phase boundaries (flush()) or when the block fills up, instead of
+// flushing on every line. Verbosity decides which lines are kept at all; silent runs
+// format nothing. The sink is stdout or a file.
+enum class LogVerbosity {
+    Silent = 0,   // Nothing
+    Summary = 1,  // Phase banners, stage results, champion
+    PerRound = 2, // Round headers, group standings
+    PerMatch = 3  // Every scheduled, played and advanced match (original behaviour)
+};
+
+class SimulationLog {
+private:
+    // Stream buffer over one fixed block. endl/flush on the stream do not force a write.
+    class BlockBuffer : public streambuf {
+    private:
+        char* block;
+        size_t blockSize;
+        ostream* sink;
+
+    protected:
+        int_type overflow(int_type ch) override {
+            drain();
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        int sync() override {
+            return 0;
+        }
+
+    public:
+        BlockBuffer(size_t size) : block(new char[size]), blockSize(size), sink(nullptr) {
+            setp(block, block + blockSize);
+        }
+
+        ~BlockBuffer() {
+            delete[] block;
+        }
+
+        void setSink(ostream* target) {
+            sink = target;
+        }
+
+        // Writes everything collected so far to the sink.
+        void drain() {
+            TRACE_SPAN("SimulationLog flush");
+            streamsize pending = pptr() - pbase();
+            if (pending > 0 && sink != nullptr) {
+                sink->write(pbase(), pending);
+            }
+            if (sink != nullptr) {
+                sink->flush();
+            }
+            setp(block, block + blockSize);
+        }
+    };
+
+    LogVerbosity verbosity;
+    BlockBuffer buffer;
+    ostream bufferedStream;
+    ostream discardStream; // No buffer: every insertion is a no-op
+    ofstream fileSink;
+
+public:
+    static const size_t DEFAULT_BUFFER_BYTES = 4 * 1024 * 1024;
+
+    SimulationLog(LogVerbosity level = LogVerbosity::PerMatch, size_t bufferBytes = DEFAULT_BUFFER_BYTES) :
+        verbosity(level), buffer(bufferBytes), bufferedStream(&buffer), discardStream(nullptr) {
+        buffer.setSink(&cout);
+    }
+
+    ~SimulationLog() {
+        flush();
+    }
+
+    SimulationLog(const SimulationLog&) = delete;
+    SimulationLog& operator=(const SimulationLog&) = delete;
+
+    void setVerbosity(LogVerbosity level) {
+        verbosity = level;
+    }
+
+    LogVerbosity getVerbosity() const {
+        return verbosity;
+    }
+
+    // Sends all further output to a file instead of stdout. Returns false if it cannot be opened.
+    bool openFile(const string& path) {
+        flush();
+        fileSink.open(path, ios::out | ios::trunc);
+        if (!fileSink.is_open()) {
+            cerr << "Error: Unable to open log file: " << path << ". Logging to stdout instead." << endl;
+            return false;
+        }
+        buffer.setSink(&fileSink);
+        return true;
+    }
+
+    bool enabled(LogVerbosity level) const {
+        return level != LogVerbosity::Silent && static_cast<int>(level) <= static_cast<int>(verbosity);
+    }
+
+    // Stream for a line at `level`; lines above the current verbosity go to a discarding stream.
+    ostream& at(LogVerbosity level) {
+        return enabled(level) ? bufferedStream : discardStream;
+    }
+
+    // Phase boundary: write out everything buffered so far.
+    void flush() {
+        buffer.drain();
+    }
+};
 
 // --- CustomQueue Class Template (from original tournament system) ---
 template <typename T>
@@ -147,6 +1052,7 @@ public:
     }
 
     void enqueue(const T& item) {
+        METRICS_ADD(QueueOperations, 1);
         Node* newNode = new Node(item);
         if (isEmpty()) {
             frontNode = rearNode = newNode;
@@ -162,6 +1068,7 @@ public:
         if (isEmpty()) {
             throw runtime_error("Queue is empty, cannot dequeue.");
         }
+        METRICS_ADD(QueueOperations, 1);
         Node* temp = frontNode;
         T data = temp->data;
         frontNode = frontNode->next;
@@ -180,6 +1087,30 @@ public:
         return frontNode->data;
     }
 
+    // Read-only walk from front to rear (for (const T& item : queue)), without copying the queue.
+    class const_iterator {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        explicit const_iterator(const Node* node = nullptr) : current(node) {}
+        const T& operator*() const { return current->data; }
+        const T* operator->() const { return &current->data; }
+        const_iterator& operator++() { current = current->next; return *this; }
+        const_iterator operator++(int) { const_iterator before = *this; current = current->next; return before; }
+        bool operator==(const const_iterator& other) const { return current == other.current; }
+        bool operator!=(const const_iterator& other) const { return current != other.current; }
+
+    private:
+        const Node* current;
+    };
+
+    const_iterator begin() const { return const_iterator(frontNode); }
+    const_iterator end() const { return const_iterator(); }
+
     // Copy constructor (deep copy)
     CustomQueue(const CustomQueue& other) : frontNode(nullptr), rearNode(nullptr), count(0) {
         Node* current = other.frontNode;
@@ -238,6 +1169,7 @@ public:
     }
 
     void push(const T& item) {
+        METRICS_ADD(QueueOperations, 1);
         Node* newNode = new Node(item);
         newNode->next = topNode;
         topNode = newNode;
@@ -248,6 +1180,7 @@ public:
         if (isEmpty()) {
             throw runtime_error("Stack is empty, cannot pop.");
         }
+        METRICS_ADD(QueueOperations, 1);
         Node* temp = topNode;
         T data = temp->data;
         topNode = topNode->next;
@@ -263,6 +1196,30 @@ public:
         return topNode->data;
     }
 
+    // Read-only walk from top to bottom (pop order), without copying the stack.
+    class const_iterator {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        explicit const_iterator(const Node* node = nullptr) : current(node) {}
+        const T& operator*() const { return current->data; }
+        const T* operator->() const { return &current->data; }
+        const_iterator& operator++() { current = current->next; return *this; }
+        const_iterator operator++(int) { const_iterator before = *this; current = current->next; return before; }
+        bool operator==(const const_iterator& other) const { return current == other.current; }
+        bool operator!=(const const_iterator& other) const { return current != other.current; }
+
+    private:
+        const Node* current;
+    };
+
+    const_iterator begin() const { return const_iterator(topNode); }
+    const_iterator end() const { return const_iterator(); }
+
     // Copy constructor (deep copy)
     CustomStack(const CustomStack& other) : topNode(nullptr), count(0) {
         if (other.topNode == nullptr) {
@@ -311,35 +1268,526 @@ public:
     }
 };
 
-// ---Struct from the old system
-struct HistoricalMatch {
-    int matchId;
-    string player1Id; // Changed from int to string
-    string player1Name;
-    string player2Id; // Changed from int to string
-    string player2Name;
-    string winnerId; // Changed from int to string
+// --- DynamicArray Class Template ---
+// Contiguous array that doubles its capacity when full. Used where the fixed
+// MAX_PLAYERS_UNIVERSAL arrays are too small (large events) and where code needs index access.
+template <typename T>
+class DynamicArray {
+private:
+    T* items;
+    int count;
+    int capacity;
+
+public:
+    DynamicArray(int initialCapacity = 0) : items(nullptr), count(0), capacity(0) {
+        reserve(initialCapacity);
+    }
+
+    ~DynamicArray() {
+        delete[] items;
+    }
+
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    int size() const {
+        return count;
+    }
+
+    int getCapacity() const {
+        return capacity;
+    }
+
+    // Grows the storage to hold at least newCapacity items (never shrinks).
+    void reserve(int newCapacity) {
+        if (newCapacity <= capacity) {
+            return;
+        }
+        T* newItems = new T[newCapacity];
+        for (int i = 0; i < count; ++i) {
+            newItems[i] = std::move(items[i]);
+        }
+        delete[] items;
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    void pushBack(const T& item) {
+        if (count == capacity) {
+            reserve(capacity == 0 ? 16 : capacity * 2);
+        }
+        items[count++] = item;
+    }
+
+    void pushBack(T&& item) {
+        if (count == capacity) {
+            reserve(capacity == 0 ? 16 : capacity * 2);
+        }
+        items[count++] = std::move(item);
+    }
+
+    T& operator[](int index) {
+        return items[index];
+    }
+
+    const T& operator[](int index) const {
+        return items[index];
+    }
+
+    T* data() {
+        return items;
+    }
+
+    const T* data() const {
+        return items;
+    }
+
+    // Forgets the contents but keeps the allocated storage for reuse.
+    void clear() {
+        count = 0;
+    }
+
+    // Drops the last item; its slot is overwritten by the next pushBack.
+    void popBack() {
+        if (count > 0) {
+            count--;
+        }
+    }
+
+    // Exchanges contents (and storage) with another array in O(1).
+    void swap(DynamicArray& other) {
+        std::swap(items, other.items);
+        std::swap(count, other.count);
+        std::swap(capacity, other.capacity);
+    }
+
+    // Copy constructor (deep copy)
+    DynamicArray(const DynamicArray& other) : items(nullptr), count(0), capacity(0) {
+        reserve(other.count);
+        for (int i = 0; i < other.count; ++i) {
+            items[i] = other.items[i];
+        }
+        count = other.count;
+    }
+
+    // Assignment operator (deep copy)
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this == &other) {
+            return *this;
+        }
+        clear();
+        reserve(other.count);
+        for (int i = 0; i < other.count; ++i) {
+            items[i] = other.items[i];
+        }
+        count = other.count;
+        return *this;
+    }
+};
+
+// --- RecentItemsRing Class Template ---
+// Keeps only the most recent `capacity` items: a push into a full ring overwrites the oldest
+// one. Storage is allocated once, and slots are assigned in place, so memory stays constant
+// however long the process runs. Items are read in place, newest first.
+template <typename T>
+class RecentItemsRing {
+private:
+    T* items;
+    int capacity;
+    int nextSlot;    // Where the next push goes
+    int count;
+    long long totalPushed;
+
+public:
+    RecentItemsRing(int ringCapacity) :
+        items(new T[ringCapacity > 0 ? ringCapacity : 1]), capacity(ringCapacity > 0 ? ringCapacity : 1),
+        nextSlot(0), count(0), totalPushed(0) {}
+
+    ~RecentItemsRing() {
+        delete[] items;
+    }
+
+    RecentItemsRing(const RecentItemsRing&) = delete;
+    RecentItemsRing& operator=(const RecentItemsRing&) = delete;
+
+    void push(const T& item) {
+        items[nextSlot] = item;
+        nextSlot = (nextSlot + 1 == capacity) ? 0 : nextSlot + 1;
+        if (count < capacity) {
+            count++;
+        }
+        totalPushed++;
+    }
+
+    // k = 0 is the newest item, k = size() - 1 the oldest still kept.
+    const T& fromNewest(int k) const {
+        int slot = nextSlot - 1 - k;
+        return items[slot < 0 ? slot + capacity : slot];
+    }
+
+    int size() const { return count; }
+    int getCapacity() const { return capacity; }
+    bool isEmpty() const { return count == 0; }
+    long long getTotalPushed() const { return totalPushed; } // Including items already overwritten
+};
+
+// --- RingBufferQueue Class Template ---
+// FIFO queue with the CustomQueue interface, stored in one contiguous ring that doubles when
+// full instead of one heap node per item. Items are constructed in place (emplace) or moved
+// in, and dequeue moves them out, so a Player or Match passes through without copying its
+// strings. Storage is kept when the queue empties, so a queue reused every round stops
+// allocating once it has reached its largest size.
+template <typename T>
+class RingBufferQueue {
+private:
+    T* slots;       // Raw storage; only [head, head + count) (mod capacity) hold live items
+    int capacity;   // Power of two (or 0)
+    int head;
+    int count;
+
+    T* slotAt(int index) const {
+        return slots + ((head + index) & (capacity - 1));
+    }
+
+    // Doubles the storage with the new rear item built from `args` first: the old items are
+    // still in place then, so `args` may refer to one of them (e.g. q.enqueue(q.front())).
+    template <typename... Args>
+    T* growAndEmplace(Args&&... args) {
+        int newCapacity = (capacity == 0) ? 16 : capacity * 2;
+        T* newSlots = static_cast<T*>(::operator new(sizeof(T) * static_cast<size_t>(newCapacity)));
+        T* item;
+        try {
+            item = new (newSlots + count) T(std::forward<Args>(args)...);
+        } catch (...) {
+            ::operator delete(newSlots); // The queue is left as it was
+            throw;
+        }
+        for (int i = 0; i < count; ++i) {
+            T* old = slotAt(i);
+            new (newSlots + i) T(std::move(*old));
+            old->~T();
+        }
+        ::operator delete(slots);
+        slots = newSlots;
+        capacity = newCapacity;
+        head = 0;
+        return item;
+    }
+
+    void copyFrom(const RingBufferQueue& other) {
+        for (int i = 0; i < other.count; ++i) {
+            enqueue(*other.slotAt(i));
+        }
+    }
+
+public:
+    RingBufferQueue() : slots(nullptr), capacity(0), head(0), count(0) {}
+
+    ~RingBufferQueue() {
+        clear();
+        ::operator delete(slots);
+    }
+
+    // Copy constructor (deep copy)
+    RingBufferQueue(const RingBufferQueue& other) : slots(nullptr), capacity(0), head(0), count(0) {
+        copyFrom(other);
+    }
+
+    // Assignment operator (deep copy)
+    RingBufferQueue& operator=(const RingBufferQueue& other) {
+        if (this != &other) {
+            clear();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    RingBufferQueue(RingBufferQueue&& other) noexcept : slots(other.slots), capacity(other.capacity), head(other.head), count(other.count) {
+        other.slots = nullptr;
+        other.capacity = other.head = other.count = 0;
+    }
+
+    RingBufferQueue& operator=(RingBufferQueue&& other) noexcept {
+        if (this != &other) {
+            clear();
+            ::operator delete(slots);
+            slots = other.slots;
+            capacity = other.capacity;
+            head = other.head;
+            count = other.count;
+            other.slots = nullptr;
+            other.capacity = other.head = other.count = 0;
+        }
+        return *this;
+    }
+
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    int size() const {
+        return count;
+    }
+
+    void enqueue(const T& item) {
+        emplace(item);
+    }
+
+    void enqueue(T&& item) {
+        emplace(std::move(item));
+    }
+
+    // Constructs the new rear item from `args` in place and returns it.
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        METRICS_ADD(QueueOperations, 1);
+        T* item = (count == capacity) ? growAndEmplace(std::forward<Args>(args)...)
+                                      : new (slotAt(count)) T(std::forward<Args>(args)...);
+        count++;
+        return *item;
+    }
+
+    T dequeue() {
+        if (isEmpty()) {
+            throw runtime_error("Queue is empty, cannot dequeue.");
+        }
+        METRICS_ADD(QueueOperations, 1);
+        T* item = slotAt(0);
+        T data(std::move(*item));
+        item->~T();
+        head = (head + 1) & (capacity - 1);
+        count--;
+        return data;
+    }
+
+    T peek() const {
+        if (isEmpty()) {
+            throw runtime_error("Queue is empty, cannot peek.");
+        }
+        return *slotAt(0);
+    }
+
+    // The front item in place (the queue must not be empty).
+    const T& front() const {
+        return *slotAt(0);
+    }
+
+    // Destroys every item but keeps the storage.
+    void clear() {
+        for (int i = 0; i < count; ++i) {
+            slotAt(i)->~T();
+        }
+        head = 0;
+        count = 0;
+    }
+
+    // Read-only walk from front to rear, as CustomQueue::const_iterator.
+    class const_iterator {
+    public:
+        typedef forward_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef ptrdiff_t difference_type;
+        typedef const T* pointer;
+        typedef const T& reference;
+
+        const_iterator(const RingBufferQueue* owner = nullptr, int index = 0) : queue(owner), position(index) {}
+        const T& operator*() const { return *queue->slotAt(position); }
+        const T* operator->() const { return queue->slotAt(position); }
+        const_iterator& operator++() { position++; return *this; }
+        const_iterator operator++(int) { const_iterator before = *this; position++; return before; }
+        bool operator==(const const_iterator& other) const { return position == other.position; }
+        bool operator!=(const const_iterator& other) const { return position != other.position; }
+
+    private:
+        const RingBufferQueue* queue;
+        int position;
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
+
+// --- BoundedMpmcQueue Class Template ---
+// Fixed-capacity lock-free queue for passing work between threads (Vyukov's bounded
+// MPMC design): every cell carries a sequence number that tells producers and consumers
+// whose turn it is, so enqueue/dequeue only need one compare-and-swap on a position counter.
+template <typename T>
+class BoundedMpmcQueue {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T data;
+    };
+
+    Cell* cells;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueuePosition; // Kept on separate cache lines
+    alignas(64) atomic<size_t> dequeuePosition;
+
+public:
+    // Capacity is rounded up to a power of two.
+    explicit BoundedMpmcQueue(size_t requestedCapacity) : enqueuePosition(0), dequeuePosition(0) {
+        size_t capacity = 2;
+        while (capacity < requestedCapacity) {
+            capacity *= 2;
+        }
+        cells = new Cell[capacity];
+        mask = capacity - 1;
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    ~BoundedMpmcQueue() {
+        delete[] cells;
+    }
+
+    BoundedMpmcQueue(const BoundedMpmcQueue&) = delete;
+    BoundedMpmcQueue& operator=(const BoundedMpmcQueue&) = delete;
+
+    // Returns false instead of blocking when the queue is full.
+    bool tryEnqueue(const T& item) {
+        Cell* cell;
+        size_t position = enqueuePosition.load(memory_order_relaxed);
+        for (;;) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // Full
+            } else {
+                position = enqueuePosition.load(memory_order_relaxed);
+            }
+        }
+        cell->data = item;
+        cell->sequence.store(position + 1, memory_order_release);
+        return true;
+    }
+
+    // Returns false instead of blocking when the queue is empty.
+    bool tryDequeue(T& item) {
+        Cell* cell;
+        size_t position = dequeuePosition.load(memory_order_relaxed);
+        for (;;) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // Empty
+            } else {
+                position = dequeuePosition.load(memory_order_relaxed);
+            }
+        }
+        item = cell->data;
+        cell->sequence.store(position + mask + 1, memory_order_release);
+        return true;
+    }
+
+    // Blocking versions: yield the core while the other side catches up.
+    void enqueue(const T& item) {
+        while (!tryEnqueue(item)) {
+            this_thread::yield();
+        }
+    }
+
+    T dequeue() {
+        T item;
+        while (!tryDequeue(item)) {
+            this_thread::yield();
+        }
+        return item;
+    }
+};
+
+// ---Struct from the old system
+// How a log entry changes the players' records. Corrections are appended rather than edited
+// in place, so the log keeps the full audit trail of every overturned or voided result.
+enum class MatchRecordType : unsigned char {
+    Result,     // A played match: winner +1 win, loser +1 loss
+    Overturned, // Referee reversed an earlier result: winnerId is the new winner
+    Voided      // Result withdrawn (the match is replayed): winnerId is the withdrawn winner
+};
+
+struct HistoricalMatch {
+    int matchId;
+    string player1Id; // Changed from int to string
+    string player1Name;
+    string player2Id; // Changed from int to string
+    string player2Name;
+    string winnerId; // Changed from int to string
     string winnerName;
+    MatchRecordType recordType;
+    int round; // Same meaning as Match::round / Match::group
+    int group;
 
     HistoricalMatch(int mId = 0, string p1Id = "", string p1N = "N/A", // Changed default id to empty string
                     string p2Id = "", string p2N = "N/A",
-                    string wId = "", string wN = "N/A")
+                    string wId = "", string wN = "N/A",
+                    MatchRecordType type = MatchRecordType::Result, int roundNumber = 0, int groupNumber = 0)
         : matchId(mId), player1Id(p1Id), player1Name(p1N),
           player2Id(p2Id), player2Name(p2N),
-          winnerId(wId), winnerName(wN) {}
+          winnerId(wId), winnerName(wN), recordType(type), round(roundNumber), group(groupNumber) {}
 
     friend ostream& operator<<(ostream& os, const HistoricalMatch& hm) {
-        os << "Match ID: " << hm.matchId << " | P1: " << hm.player1Name << " (ID:" << hm.player1Id << ")"
-           << " vs P2: " << hm.player2Name << " (ID:" << hm.player2Id << ")";
-        if (hm.winnerId != "") { // Assuming empty string player ID is not a valid playing ID
-            os << " | Winner: " << hm.winnerName << " (ID:" << hm.winnerId << ")";
+        return print(os, hm.matchId, hm.player1Id, hm.player1Name, hm.player2Id, hm.player2Name,
+                     hm.winnerId, hm.winnerName, hm.recordType, hm.round, hm.group);
+    }
+
+    // Same line as operator<<, for callers that hold the fields elsewhere (see ColumnarMatchLog::printRow).
+    static ostream& print(ostream& os, int matchId, const string& player1Id, const string& player1Name,
+                          const string& player2Id, const string& player2Name, const string& winnerId,
+                          const string& winnerName, MatchRecordType recordType, int round, int group) {
+        os << "Match ID: " << matchId << " | P1: " << player1Name << " (ID:" << player1Id << ")"
+           << " vs P2: " << player2Name << " (ID:" << player2Id << ")";
+        if (winnerId != "") { // Assuming empty string player ID is not a valid playing ID
+            os << " | Winner: " << winnerName << " (ID:" << winnerId << ")";
         } else {
             os << " | Winner: TBD / Draw / No valid winner";
         }
+        if (recordType == MatchRecordType::Overturned) {
+            os << " [Result overturned]";
+        } else if (recordType == MatchRecordType::Voided) {
+            os << " [Voided, to be replayed]";
+        }
+        if (group > 0) {
+            os << " (Group " << group << ", Round " << round << ")";
+        } else if (round > 0) {
+            os << " (Round " << round << ")";
+        }
         return os;
     }
 };
 
+// --- EloRating ---
+// Streaming rating, updated with every recorded result (1500 to start, 400-point logistic
+// scale). A win moves K * (1 - expected score) points from the loser to the winner, so points
+// only ever change hands. Corrections move points back at the players' current ratings: a
+// void takes back what the withdrawn win would earn now, and an overturn moves exactly K
+// points (the returned win plus the new one).
+struct EloRating {
+    static constexpr double INITIAL = 1500.0;
+    static constexpr double K_FACTOR = 32.0;
+
+    // Expected score (0..1) of a player rated `rating` against one rated `opponent`.
+    static double expectedScore(double rating, double opponent) {
+        return 1.0 / (1.0 + pow(10.0, (opponent - rating) / 400.0));
+    }
+
+    // Points a win by a player rated `winner` over one rated `loser` moves between them.
+    static double winShift(double winner, double loser) {
+        return K_FACTOR * (1.0 - expectedScore(winner, loser));
+    }
+};
+
 // --- PlayerStats Struct
 struct PlayerStats {
     string playerId; // Changed from int to string
@@ -347,574 +1795,4601 @@ struct PlayerStats {
     int initialRank; 
     int wins;
     int losses;
+    double rating;         // EloRating, updated with every result
+    double startingRating; // Rating before this event's first match (saved in checkpoints)
 
-    PlayerStats(string id = "", string name = "N/A", int r = 9999) // Changed default id to empty string
-        : playerId(id), playerName(name), initialRank(r), wins(0), losses(0) {}
+    PlayerStats(string id = "", string name = "N/A", int r = 9999, double startRating = EloRating::INITIAL) // Changed default id to empty string
+        : playerId(std::move(id)), playerName(std::move(name)), initialRank(r), wins(0), losses(0), rating(startRating), startingRating(startRating) {}
 
     void recordWin() { wins++; }
     void recordLoss() { losses++; }
+    void undoWin() { if (wins > 0) wins--; }
+    void undoLoss() { if (losses > 0) losses--; }
     int totalMatchesPlayed() const { return wins + losses; }
 
-    friend ostream& operator<<(ostream& os, const PlayerStats& ps) {
-        os << "Player: " << ps.playerName << " (ID: " << ps.playerId << ", Initial Rank: " << ps.initialRank << ") | "
-           << "Wins: " << ps.wins << ", Losses: " << ps.losses
-           << ", Matches Played: " << ps.totalMatchesPlayed();
-        return os;
+    friend ostream& operator<<(ostream& os, const PlayerStats& ps) {
+        os << "Player: " << ps.playerName << " (ID: " << ps.playerId << ", Initial Rank: " << ps.initialRank << ") | "
+           << "Wins: " << ps.wins << ", Losses: " << ps.losses
+           << ", Matches Played: " << ps.totalMatchesPlayed() << ", Rating: " << lround(ps.rating);
+        return os;
+    }
+};
+
+
+// --- PlayerIdIndex ---
+// Open-addressing hash index from a player's PlayerIdCodec key to a position in a
+// caller-owned array of records (linear probing, table kept at most half full). The slots
+// hold the keys themselves, so a probe is an integer compare and never touches the records.
+class PlayerIdIndex {
+private:
+    struct Slot {
+        PlayerKey key;
+        int position;     // -1 for an empty slot
+    };
+
+    Slot* slots;
+    unsigned int mask;    // Table size - 1 (size is a power of two)
+    int count;
+
+    static unsigned long long hashKey(PlayerKey key) {
+        key ^= key >> 30; // splitmix64 finalizer: packed IDs differ mostly in their high bits
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        return key ^ (key >> 31);
+    }
+
+    void allocate(unsigned int tableSize) {
+        slots = new Slot[tableSize];
+        mask = tableSize - 1;
+        for (unsigned int i = 0; i < tableSize; ++i) {
+            slots[i].position = -1;
+        }
+    }
+
+    void placeSlot(PlayerKey key, int position) {
+        unsigned int bucket = static_cast<unsigned int>(hashKey(key)) & mask;
+        while (slots[bucket].position >= 0) {
+            bucket = (bucket + 1) & mask;
+        }
+        slots[bucket].key = key;
+        slots[bucket].position = position;
+    }
+
+public:
+    PlayerIdIndex(int expectedCount = 0) : slots(nullptr), mask(0), count(0) {
+        unsigned int tableSize = 16;
+        while (tableSize < static_cast<unsigned int>(expectedCount) * 2) {
+            tableSize *= 2;
+        }
+        allocate(tableSize);
+    }
+
+    ~PlayerIdIndex() {
+        delete[] slots;
+    }
+
+    PlayerIdIndex(const PlayerIdIndex&) = delete;
+    PlayerIdIndex& operator=(const PlayerIdIndex&) = delete;
+
+    int size() const {
+        return count;
+    }
+
+    // Forgets every key (keeps the table size).
+    void clear() {
+        for (unsigned int i = 0; i <= mask; ++i) {
+            slots[i].position = -1;
+        }
+        count = 0;
+    }
+
+    // Position of the record with this key, or -1.
+    int find(PlayerKey key) const {
+        unsigned int bucket = static_cast<unsigned int>(hashKey(key)) & mask;
+        while (slots[bucket].position >= 0) {
+            METRICS_ADD(ScanSteps, 1);
+            if (slots[bucket].key == key) {
+                return slots[bucket].position;
+            }
+            bucket = (bucket + 1) & mask;
+        }
+        return -1;
+    }
+
+    // Same, by the ID's text (e.g. typed in by the user); never interns it.
+    int find(const string& id) const {
+        PlayerKey key;
+        return PlayerIdCodec::lookup(id, key) ? find(key) : -1;
+    }
+
+    // Adds a key that is not in the index yet.
+    void insert(PlayerKey key, int position) {
+        if (static_cast<unsigned int>(count + 1) * 2 > mask + 1) {
+            unsigned int oldSize = mask + 1;
+            Slot* oldSlots = slots;
+            allocate(oldSize * 2);
+            for (unsigned int i = 0; i < oldSize; ++i) {
+                if (oldSlots[i].position >= 0) {
+                    placeSlot(oldSlots[i].key, oldSlots[i].position);
+                }
+            }
+            delete[] oldSlots;
+        }
+        placeSlot(key, position);
+        count++;
+    }
+};
+
+// --- PlayerLeaderboard ---
+// Standings kept in order as results come in. Every order depends only on a small integer
+// key: the (wins, losses) record, or the rating to the nearest point. Players are grouped
+// into one bucket per distinct key, each bucket holding its players in a linked list. An
+// order-statistic treap orders the buckets and counts the players under every subtree; it
+// only has as many nodes as there are distinct keys held right now (emptied buckets are
+// recycled), so it stays small and cached. A result unlinks the player from one bucket and
+// appends them to another (O(log b) for b buckets), the place of any player takes O(log b),
+// and the top K are an in-order walk of O(K + log b).
+// Players with the same key share a place (1, 2, 2, 4, ...) and are listed in the order they
+// reached it. Players are addressed by their position in the caller's stats array.
+enum class LeaderboardOrder {
+    Wins,    // Most wins, then fewest losses
+    WinRate, // Highest wins / matches played, then most wins, then fewest losses (no matches counts as 0%)
+    Rating   // Highest EloRating, to the nearest point
+};
+
+class PlayerLeaderboard {
+private:
+    struct Bucket {
+        int primary;    // Wins, or the rounded rating
+        int secondary;  // Losses (0 for the rating order)
+        int head;       // First and last player in this bucket, -1 when empty
+        int tail;
+        int count;      // Players in this bucket
+        int left;       // Treap links, -1 for none
+        int right;
+        int total;      // Players in this treap subtree
+        unsigned int priority;
+    };
+
+    struct Entry {
+        int prev;       // Neighbours in the bucket's list, -1 for none
+        int next;
+        int bucket;
+    };
+
+    LeaderboardOrder order;
+    DynamicArray<Bucket> buckets;
+    DynamicArray<Entry> entries; // One per player position
+    int root;
+
+    int* bucketSlots;            // (primary, secondary) -> bucket, open addressing; -1 for an empty slot
+    unsigned int slotMask;       // Table size - 1 (size is a power of two)
+    DynamicArray<int> freeBuckets; // Emptied buckets, reused for the next new key
+
+    static unsigned long long hashKey(int primary, int secondary) { // splitmix64 of the packed key
+        unsigned long long z = (static_cast<unsigned long long>(static_cast<unsigned int>(primary)) << 32)
+                               | static_cast<unsigned int>(secondary);
+        z += 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    void allocateSlots(unsigned int tableSize) {
+        bucketSlots = new int[tableSize];
+        slotMask = tableSize - 1;
+        for (unsigned int i = 0; i < tableSize; ++i) {
+            bucketSlots[i] = -1;
+        }
+    }
+
+    unsigned int homeSlot(int bucket) const {
+        return static_cast<unsigned int>(hashKey(buckets[bucket].primary, buckets[bucket].secondary)) & slotMask;
+    }
+
+    void placeSlot(int bucket) {
+        unsigned int slot = homeSlot(bucket);
+        while (bucketSlots[slot] >= 0) {
+            slot = (slot + 1) & slotMask;
+        }
+        bucketSlots[slot] = bucket;
+    }
+
+    // Takes an emptied bucket out of the table, shifting later entries of its probe run back.
+    void releaseBucket(int bucket) {
+        unsigned int hole = homeSlot(bucket);
+        while (bucketSlots[hole] != bucket) {
+            hole = (hole + 1) & slotMask;
+        }
+        for (unsigned int slot = (hole + 1) & slotMask; bucketSlots[slot] >= 0; slot = (slot + 1) & slotMask) {
+            unsigned int home = homeSlot(bucketSlots[slot]);
+            if (((slot - home) & slotMask) >= ((slot - hole) & slotMask)) {
+                bucketSlots[hole] = bucketSlots[slot];
+                hole = slot;
+            }
+        }
+        bucketSlots[hole] = -1;
+        freeBuckets.pushBack(bucket);
+    }
+
+    void keyOf(const PlayerStats& stats, int& primary, int& secondary) const {
+        if (order == LeaderboardOrder::Rating) {
+            primary = static_cast<int>(lround(stats.rating));
+            secondary = 0;
+        } else {
+            primary = stats.wins;
+            secondary = stats.losses;
+        }
+    }
+
+    // Bucket for this key, created (empty, outside the treap) on first use.
+    int bucketFor(int primary, int secondary) {
+        unsigned int slot = static_cast<unsigned int>(hashKey(primary, secondary)) & slotMask;
+        while (bucketSlots[slot] >= 0) {
+            const Bucket& bucket = buckets[bucketSlots[slot]];
+            if (bucket.primary == primary && bucket.secondary == secondary) {
+                return bucketSlots[slot];
+            }
+            slot = (slot + 1) & slotMask;
+        }
+
+        int bucket;
+        if (!freeBuckets.isEmpty()) {
+            bucket = freeBuckets[freeBuckets.size() - 1];
+            freeBuckets.popBack();
+            buckets[bucket].primary = primary;
+            buckets[bucket].secondary = secondary;
+        } else {
+            if (static_cast<unsigned int>(buckets.size() + 1) * 2 > slotMask + 1) {
+                unsigned int oldSize = slotMask + 1;
+                delete[] bucketSlots;
+                allocateSlots(oldSize * 2);
+                for (int b = 0; b < buckets.size(); ++b) {
+                    placeSlot(b); // Every bucket is in use when none are free
+                }
+            }
+            bucket = buckets.size();
+            Bucket fresh = {primary, secondary, -1, -1, 0, -1, -1, 0,
+                            static_cast<unsigned int>(hashKey(bucket, 0) >> 32)};
+            buckets.pushBack(fresh);
+        }
+        placeSlot(bucket);
+        return bucket;
+    }
+
+    int totalOf(int bucket) const {
+        return (bucket < 0) ? 0 : buckets[bucket].total;
+    }
+
+    void resize(int bucket) {
+        buckets[bucket].total = buckets[bucket].count + totalOf(buckets[bucket].left) + totalOf(buckets[bucket].right);
+    }
+
+    // True if players in bucket `a` are placed ahead of players in bucket `b`.
+    bool ahead(int a, int b) const {
+        const Bucket& x = buckets[a];
+        const Bucket& y = buckets[b];
+        if (order == LeaderboardOrder::WinRate) { // primary = wins, secondary = losses
+            long long lhs = static_cast<long long>(x.primary) * (y.primary + y.secondary);
+            long long rhs = static_cast<long long>(y.primary) * (x.primary + x.secondary);
+            if (lhs != rhs) return lhs > rhs;
+        }
+        if (x.primary != y.primary) return x.primary > y.primary;
+        return x.secondary < y.secondary;
+    }
+
+    // Splits `tree` into the buckets ahead of `pivot` and the rest.
+    void split(int tree, int pivot, int& aheadPart, int& behindPart) {
+        if (tree < 0) {
+            aheadPart = behindPart = -1;
+            return;
+        }
+        if (ahead(tree, pivot)) {
+            split(buckets[tree].right, pivot, buckets[tree].right, behindPart);
+            aheadPart = tree;
+        } else {
+            split(buckets[tree].left, pivot, aheadPart, buckets[tree].left);
+            behindPart = tree;
+        }
+        resize(tree);
+    }
+
+    int merge(int aheadPart, int behindPart) {
+        if (aheadPart < 0) return behindPart;
+        if (behindPart < 0) return aheadPart;
+        if (buckets[aheadPart].priority > buckets[behindPart].priority) {
+            buckets[aheadPart].right = merge(buckets[aheadPart].right, behindPart);
+            resize(aheadPart);
+            return aheadPart;
+        }
+        buckets[behindPart].left = merge(aheadPart, buckets[behindPart].left);
+        resize(behindPart);
+        return behindPart;
+    }
+
+    int eraseBucket(int tree, int bucket) {
+        if (tree == bucket) {
+            return merge(buckets[bucket].left, buckets[bucket].right);
+        }
+        if (ahead(bucket, tree)) {
+            buckets[tree].left = eraseBucket(buckets[tree].left, bucket);
+        } else {
+            buckets[tree].right = eraseBucket(buckets[tree].right, bucket);
+        }
+        resize(tree);
+        return tree;
+    }
+
+    // Adds `delta` to the player totals on the path from the root down to a bucket in the treap.
+    void adjustTotals(int bucket, int delta) {
+        int tree = root;
+        while (tree != bucket) {
+            buckets[tree].total += delta;
+            tree = ahead(bucket, tree) ? buckets[tree].left : buckets[tree].right;
+        }
+        buckets[bucket].total += delta;
+    }
+
+    void link(int position, int bucket) {
+        Bucket& target = buckets[bucket];
+        Entry& entry = entries[position];
+        entry.prev = target.tail;
+        entry.next = -1;
+        entry.bucket = bucket;
+        if (target.tail >= 0) {
+            entries[target.tail].next = position;
+        } else {
+            target.head = position;
+        }
+        target.tail = position;
+        target.count++;
+
+        if (target.count > 1) {
+            adjustTotals(bucket, 1);
+        } else {
+            target.left = target.right = -1;
+            target.total = 1;
+            int aheadPart, behindPart;
+            split(root, bucket, aheadPart, behindPart);
+            root = merge(merge(aheadPart, bucket), behindPart);
+        }
+    }
+
+    void unlink(int position) {
+        Entry& entry = entries[position];
+        Bucket& source = buckets[entry.bucket];
+        if (entry.prev >= 0) entries[entry.prev].next = entry.next; else source.head = entry.next;
+        if (entry.next >= 0) entries[entry.next].prev = entry.prev; else source.tail = entry.prev;
+        source.count--;
+
+        if (source.count > 0) {
+            adjustTotals(entry.bucket, -1);
+        } else {
+            root = eraseBucket(root, entry.bucket);
+            releaseBucket(entry.bucket);
+        }
+    }
+
+public:
+    explicit PlayerLeaderboard(LeaderboardOrder sortOrder) : order(sortOrder), root(-1) {
+        allocateSlots(64);
+    }
+
+    ~PlayerLeaderboard() {
+        delete[] bucketSlots;
+    }
+
+    PlayerLeaderboard(const PlayerLeaderboard&) = delete;
+    PlayerLeaderboard& operator=(const PlayerLeaderboard&) = delete;
+
+    LeaderboardOrder getOrder() const { return order; }
+    int size() const { return entries.size(); }
+
+    // Adds the player at the next position (positions must be added as 0, 1, 2, ...).
+    void addPlayer(int position, const PlayerStats& stats) {
+        int primary, secondary;
+        keyOf(stats, primary, secondary);
+        Entry entry = {-1, -1, -1};
+        entries.pushBack(entry);
+        link(position, bucketFor(primary, secondary));
+    }
+
+    // Moves a player to the place their new stats earn.
+    void updatePlayer(int position, const PlayerStats& stats) {
+        int primary, secondary;
+        keyOf(stats, primary, secondary);
+        const Bucket& current = buckets[entries[position].bucket];
+        if (current.primary == primary && current.secondary == secondary) {
+            return;
+        }
+        int target = bucketFor(primary, secondary);
+        unlink(position);
+        link(position, target);
+    }
+
+    // Place of a player, 1 = leader; players with the same key share a place.
+    int placeOf(int position) const {
+        int bucket = entries[position].bucket;
+        int place = 1;
+        int tree = root;
+        while (tree != bucket) {
+            if (ahead(bucket, tree)) {
+                tree = buckets[tree].left;
+            } else {
+                place += totalOf(buckets[tree].left) + buckets[tree].count;
+                tree = buckets[tree].right;
+            }
+        }
+        return place + totalOf(buckets[bucket].left);
+    }
+
+    // True if two players have the same key (and so share a place).
+    bool tied(int position1, int position2) const {
+        return entries[position1].bucket == entries[position2].bucket;
+    }
+
+    // Appends the positions of the first `count` players, leader first.
+    void collectTop(int count, DynamicArray<int>& out) const {
+        DynamicArray<int> path; // In-order walk over the buckets with an explicit stack
+        int tree = root;
+        int collected = 0;
+        while (collected < count && (tree >= 0 || !path.isEmpty())) {
+            while (tree >= 0) {
+                path.pushBack(tree);
+                tree = buckets[tree].left;
+            }
+            tree = path[path.size() - 1];
+            path.popBack();
+            for (int player = buckets[tree].head; player >= 0 && collected < count; player = entries[player].next) {
+                out.pushBack(player);
+                collected++;
+            }
+            tree = buckets[tree].right;
+        }
+    }
+};
+
+// --- Checkpoint Serialization ---
+// Little helpers that turn tournament state into a compact binary byte string and back.
+// Integers are written in the machine's native byte order; strings are length-prefixed.
+class CheckpointWriter {
+private:
+    string bytes;
+
+public:
+    void writeUInt8(unsigned char value) {
+        bytes.push_back(static_cast<char>(value));
+    }
+    void writeInt32(int value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    void writeUInt32(unsigned int value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    void writeUInt64(unsigned long long value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    void writeDouble(double value) {
+        bytes.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    void writeString(const string& value) {
+        writeUInt32(static_cast<unsigned int>(value.size()));
+        bytes.append(value);
+    }
+    void writePlayer(const Player& player) {
+        writeString(player.playerId);
+        writeString(player.playerName);
+        writeInt32(player.ranking);
+        writeString(player.registrationStatus);
+        writeString(player.registrationTime);
+        writeString(player.originalPriority);
+    }
+    void writeMatch(const Match& match) {
+        writeInt32(match.matchId);
+        writePlayer(match.player1);
+        writePlayer(match.player2);
+        writePlayer(match.winner);
+        writeUInt8(match.played ? 1 : 0);
+        writeInt32(match.round);
+        writeInt32(match.group);
+    }
+    void writeHistoricalMatch(const HistoricalMatch& hm) {
+        writeInt32(hm.matchId);
+        writeString(hm.player1Id);
+        writeString(hm.player1Name);
+        writeString(hm.player2Id);
+        writeString(hm.player2Name);
+        writeString(hm.winnerId);
+        writeString(hm.winnerName);
+        writeUInt8(static_cast<unsigned char>(hm.recordType));
+        writeInt32(hm.round);
+        writeInt32(hm.group);
+    }
+
+    const string& data() const {
+        return bytes;
+    }
+    void clear() {
+        bytes.clear();
+    }
+};
+
+class CheckpointReader {
+private:
+    const char* bytes;
+    size_t length;
+    size_t position;
+
+    void need(size_t count) {
+        if (length - position < count) {
+            throw runtime_error("Checkpoint data is truncated.");
+        }
+    }
+
+public:
+    CheckpointReader(const char* data, size_t size) : bytes(data), length(size), position(0) {}
+
+    bool atEnd() const {
+        return position == length;
+    }
+
+    unsigned char readUInt8() {
+        need(1);
+        return static_cast<unsigned char>(bytes[position++]);
+    }
+    int readInt32() {
+        int value;
+        need(sizeof(value));
+        memcpy(&value, bytes + position, sizeof(value));
+        position += sizeof(value);
+        return value;
+    }
+    unsigned int readUInt32() {
+        unsigned int value;
+        need(sizeof(value));
+        memcpy(&value, bytes + position, sizeof(value));
+        position += sizeof(value);
+        return value;
+    }
+    unsigned long long readUInt64() {
+        unsigned long long value;
+        need(sizeof(value));
+        memcpy(&value, bytes + position, sizeof(value));
+        position += sizeof(value);
+        return value;
+    }
+    double readDouble() {
+        double value;
+        need(sizeof(value));
+        memcpy(&value, bytes + position, sizeof(value));
+        position += sizeof(value);
+        return value;
+    }
+    string readString() {
+        unsigned int size = readUInt32();
+        need(size);
+        string value(bytes + position, size);
+        position += size;
+        return value;
+    }
+    Player readPlayer() {
+        Player player;
+        player.setId(readString());
+        player.playerName = readString();
+        player.ranking = readInt32();
+        player.registrationStatus = readString();
+        player.registrationTime = readString();
+        player.originalPriority = readString();
+        return player;
+    }
+    Match readMatch() {
+        Match match(readInt32());
+        match.player1 = readPlayer();
+        match.player2 = readPlayer();
+        match.winner = readPlayer();
+        match.played = (readUInt8() != 0);
+        match.round = readInt32();
+        match.group = readInt32();
+        return match;
+    }
+    HistoricalMatch readHistoricalMatch() {
+        HistoricalMatch hm;
+        hm.matchId = readInt32();
+        hm.player1Id = readString();
+        hm.player1Name = readString();
+        hm.player2Id = readString();
+        hm.player2Name = readString();
+        hm.winnerId = readString();
+        hm.winnerName = readString();
+        hm.recordType = static_cast<MatchRecordType>(readUInt8());
+        hm.round = readInt32();
+        hm.group = readInt32();
+        return hm;
+    }
+};
+
+// --- ColumnarMatchLog ---
+// Append-only match history stored column by column. Rows live in fixed-size chunks of
+// parallel arrays, so appending never allocates per row and a scan over one column reads
+// memory sequentially. Players are interned once in a player table; rows hold indices into
+// it instead of ID and name strings. Every row also links to the next row of each of its two
+// players, so one player's matches can be walked without touching the rest of the log.
+class ColumnarMatchLog {
+public:
+    static const int CHUNK_SHIFT = 12;
+    static const int CHUNK_ROWS = 1 << CHUNK_SHIFT; // 4096 rows (about 135 KB) per chunk
+
+    struct Chunk {
+        int matchId[CHUNK_ROWS];
+        int player1[CHUNK_ROWS];              // Player table indices
+        int player2[CHUNK_ROWS];
+        int winner[CHUNK_ROWS];               // Player table index, -1 if no valid winner
+        int nextForPlayer1[CHUNK_ROWS];       // Next row involving player1 / player2, -1 at the end
+        int nextForPlayer2[CHUNK_ROWS];
+        int round[CHUNK_ROWS];                // Match::round / Match::group
+        int group[CHUNK_ROWS];
+        unsigned char recordType[CHUNK_ROWS]; // MatchRecordType
+    };
+
+private:
+    struct LoggedPlayer {
+        string playerId;
+        string playerName; // As first logged
+        int rank;          // Seeding rank as first logged, 0 if unknown
+        int firstRow;      // Chain of this player's rows, -1 while empty
+        int lastRow;
+        int matchCount;
+    };
+
+    DynamicArray<LoggedPlayer> players;
+    PlayerIdIndex playerIndex;
+    DynamicArray<Chunk*> chunks;
+    int numRows;
+
+    int internPlayer(PlayerKey playerKey, const string& playerId, const string& playerName, int rank) {
+        int player = playerIndex.find(playerKey);
+        if (player >= 0) {
+            return player;
+        }
+        LoggedPlayer entry;
+        entry.playerId = playerId;
+        entry.playerName = playerName;
+        entry.rank = rank;
+        entry.firstRow = entry.lastRow = -1;
+        entry.matchCount = 0;
+        players.pushBack(entry);
+        playerIndex.insert(playerKey, players.size() - 1);
+        return players.size() - 1;
+    }
+
+    // The link in `row` that continues `player`'s chain.
+    int& nextLinkOf(int row, int player) {
+        Chunk& chunk = *chunks[row >> CHUNK_SHIFT];
+        int offset = row & (CHUNK_ROWS - 1);
+        return (chunk.player1[offset] == player) ? chunk.nextForPlayer1[offset] : chunk.nextForPlayer2[offset];
+    }
+
+    void linkRow(int row, int player) {
+        LoggedPlayer& entry = players[player];
+        if (entry.lastRow < 0) {
+            entry.firstRow = row;
+        } else {
+            nextLinkOf(entry.lastRow, player) = row;
+        }
+        entry.lastRow = row;
+        entry.matchCount++;
+    }
+
+public:
+    ColumnarMatchLog() : playerIndex(MAX_PLAYERS_UNIVERSAL), numRows(0) {}
+
+    ~ColumnarMatchLog() {
+        for (int c = 0; c < chunks.size(); ++c) {
+            delete chunks[c];
+        }
+    }
+
+    ColumnarMatchLog(const ColumnarMatchLog&) = delete;
+    ColumnarMatchLog& operator=(const ColumnarMatchLog&) = delete;
+
+    // Appends one match and returns its row. Ranks are only used the first time a player is seen.
+    // The keys are the players' idKeys (PlayerIdCodec::encode of the IDs; 0 for no winner).
+    int append(int matchId, PlayerKey player1Key, const string& player1Id, const string& player1Name, int player1Rank,
+               PlayerKey player2Key, const string& player2Id, const string& player2Name, int player2Rank,
+               PlayerKey winnerKey, const string& winnerId, const string& winnerName, MatchRecordType type, int round, int group) {
+        if ((numRows & (CHUNK_ROWS - 1)) == 0) {
+            chunks.pushBack(new Chunk);
+        }
+        int player1 = internPlayer(player1Key, player1Id, player1Name, player1Rank);
+        int player2 = internPlayer(player2Key, player2Id, player2Name, player2Rank);
+        int winner = -1;
+        if (winnerKey == player1Key) winner = player1;
+        else if (winnerKey == player2Key) winner = player2;
+        else if (winnerKey != 0) winner = internPlayer(winnerKey, winnerId, winnerName, 0);
+
+        int row = numRows++;
+        Chunk& chunk = *chunks[row >> CHUNK_SHIFT];
+        int offset = row & (CHUNK_ROWS - 1);
+        chunk.matchId[offset] = matchId;
+        chunk.player1[offset] = player1;
+        chunk.player2[offset] = player2;
+        chunk.winner[offset] = winner;
+        chunk.nextForPlayer1[offset] = -1;
+        chunk.nextForPlayer2[offset] = -1;
+        chunk.round[offset] = round;
+        chunk.group[offset] = group;
+        chunk.recordType[offset] = static_cast<unsigned char>(type);
+        linkRow(row, player1);
+        if (player2 != player1) {
+            linkRow(row, player2);
+        }
+        return row;
+    }
+
+    // Same, encoding the IDs (restores from checkpoints and history files).
+    int append(int matchId, const string& player1Id, const string& player1Name, int player1Rank,
+               const string& player2Id, const string& player2Name, int player2Rank,
+               const string& winnerId, const string& winnerName, MatchRecordType type, int round, int group) {
+        return append(matchId, PlayerIdCodec::encode(player1Id), player1Id, player1Name, player1Rank,
+                      PlayerIdCodec::encode(player2Id), player2Id, player2Name, player2Rank,
+                      PlayerIdCodec::encode(winnerId), winnerId, winnerName, type, round, group);
+    }
+
+    int size() const { return numRows; }
+    bool isEmpty() const { return numRows == 0; }
+
+    // Rebuilds the full record of one row (allocates its strings; use the columns for scans).
+    HistoricalMatch getMatch(int row) const {
+        const Chunk& chunk = *chunks[row >> CHUNK_SHIFT];
+        int offset = row & (CHUNK_ROWS - 1);
+        const LoggedPlayer& player1 = players[chunk.player1[offset]];
+        const LoggedPlayer& player2 = players[chunk.player2[offset]];
+        HistoricalMatch hm(chunk.matchId[offset], player1.playerId, player1.playerName, player2.playerId, player2.playerName);
+        if (chunk.winner[offset] >= 0) {
+            hm.winnerId = players[chunk.winner[offset]].playerId;
+            hm.winnerName = players[chunk.winner[offset]].playerName;
+        } else {
+            hm.winnerId = "";
+        }
+        hm.recordType = static_cast<MatchRecordType>(chunk.recordType[offset]);
+        hm.round = chunk.round[offset];
+        hm.group = chunk.group[offset];
+        return hm;
+    }
+
+    // Prints a row as `out << getMatch(row)` would, straight from the columns (no allocation).
+    ostream& printRow(ostream& out, int row) const {
+        static const string NO_WINNER;
+        const Chunk& chunk = *chunks[row >> CHUNK_SHIFT];
+        int offset = row & (CHUNK_ROWS - 1);
+        const LoggedPlayer& player1 = players[chunk.player1[offset]];
+        const LoggedPlayer& player2 = players[chunk.player2[offset]];
+        const LoggedPlayer* winner = (chunk.winner[offset] >= 0) ? &players[chunk.winner[offset]] : nullptr;
+        return HistoricalMatch::print(out, chunk.matchId[offset], player1.playerId, player1.playerName,
+                                      player2.playerId, player2.playerName,
+                                      (winner != nullptr) ? winner->playerId : NO_WINNER,
+                                      (winner != nullptr) ? winner->playerName : NO_WINNER,
+                                      static_cast<MatchRecordType>(chunk.recordType[offset]),
+                                      chunk.round[offset], chunk.group[offset]);
+    }
+
+    // --- Player table ---
+    int getNumPlayers() const { return players.size(); }
+    int findPlayer(const string& playerId) const { return playerIndex.find(playerId); } // -1 if never logged
+    const string& getPlayerId(int player) const { return players[player].playerId; }
+    const string& getPlayerName(int player) const { return players[player].playerName; }
+    int getPlayerRank(int player) const { return players[player].rank; }
+    int getPlayerMatchCount(int player) const { return players[player].matchCount; }
+    int getFirstRowOfPlayer(int player) const { return players[player].firstRow; }
+
+    // Next row of `player`'s chain after `row` (which must involve the player), or -1.
+    int getNextRowOfPlayer(int row, int player) const {
+        const Chunk& chunk = *chunks[row >> CHUNK_SHIFT];
+        int offset = row & (CHUNK_ROWS - 1);
+        return (chunk.player1[offset] == player) ? chunk.nextForPlayer1[offset] : chunk.nextForPlayer2[offset];
+    }
+
+    // --- Column access for sequential scans ---
+    int getNumChunks() const { return chunks.size(); }
+    const Chunk& getChunk(int c) const { return *chunks[c]; }
+    int getRowsInChunk(int c) const {
+        return (c < chunks.size() - 1) ? CHUNK_ROWS : numRows - c * CHUNK_ROWS;
+    }
+
+};
+
+// --- MatchHistoryFile ---
+// On-disk, append-only copy of the match log for other processes to read while the event is
+// still running. The file is a 64-byte header followed by fixed 128-byte records:
+//   header:  "TNMH" + format version + record size + committed record count
+//   records: MatchHistoryRecord, in the order recordMatchOutcome saw them
+// Records are written through a stdio buffer and made durable in batches: every `syncEvery`
+// records the writer flushes, syncs the records to disk and only then raises the committed
+// count in the header. Readers never look past that count, so they see whole batches only,
+// and a crash loses at most the batch in progress.
+struct MatchHistoryRecord {
+    static const int ID_CHARS = 16;   // Longer IDs and names are truncated (no terminator when full)
+    static const int NAME_CHARS = 40;
+
+    int matchId;
+    unsigned char winnerSide;         // 1 or 2, 0 if the winner is neither player
+    unsigned char recordType;         // MatchRecordType
+    unsigned char reserved[2];
+    unsigned int player1IdHash;       // idHash of the full IDs, so truncated IDs stay distinct
+    unsigned int player2IdHash;
+    char player1Id[ID_CHARS];
+    char player1Name[NAME_CHARS];
+    char player2Id[ID_CHARS];
+    char player2Name[NAME_CHARS];
+
+    static void setField(char* field, int capacity, const string& value) {
+        memset(field, 0, capacity);
+        memcpy(field, value.data(), value.size() < static_cast<size_t>(capacity) ? value.size() : capacity);
+    }
+    static int fieldLength(const char* field, int capacity) {
+        int length = 0;
+        while (length < capacity && field[length] != '\0') {
+            length++;
+        }
+        return length;
+    }
+    // Compares a fixed-size field with a string without allocating.
+    static bool fieldEquals(const char* field, int capacity, const string& value) {
+        int length = fieldLength(field, capacity);
+        return value.size() == static_cast<size_t>(length) && value.compare(0, length, field, length) == 0;
+    }
+
+    // 32-bit FNV-1a of a full player ID.
+    static unsigned int idHash(const string& id) {
+        unsigned int hash = 2166136261u;
+        for (size_t i = 0; i < id.size(); ++i) {
+            hash = (hash ^ static_cast<unsigned char>(id[i])) * 16777619u;
+        }
+        return hash;
+    }
+
+    // How a file identifies a player: the ID itself if it fits in ID_CHARS, otherwise its first
+    // ID_CHARS characters, '#' and its idHash in hex (e.g. for reports and season ratings).
+    static string storedId(const string& id) {
+        if (id.size() <= static_cast<size_t>(ID_CHARS)) {
+            return id;
+        }
+        return storedId(id.data(), idHash(id));
+    }
+    static string storedId(const char* field, unsigned int hash) {
+        int length = fieldLength(field, ID_CHARS);
+        string id(field, length);
+        if (length == ID_CHARS) { // Possibly truncated
+            static const char HEX[] = "0123456789abcdef";
+            id += '#';
+            for (int shift = 28; shift >= 0; shift -= 4) {
+                id += HEX[(hash >> shift) & 15];
+            }
+        }
+        return id;
+    }
+    string playerStoredId(int side) const {
+        return (side == 1) ? storedId(player1Id, player1IdHash) : storedId(player2Id, player2IdHash);
+    }
+    string playerName(int side) const {
+        const char* name = (side == 1) ? player1Name : player2Name;
+        return string(name, fieldLength(name, NAME_CHARS));
+    }
+
+    // True if player `side` (1 or 2) has the full ID `playerId`; `playerHash` is its idHash.
+    bool hasPlayer(int side, const string& playerId, unsigned int playerHash) const {
+        const char* field = (side == 1) ? player1Id : player2Id;
+        if (playerId.size() <= static_cast<size_t>(ID_CHARS)) {
+            return fieldEquals(field, ID_CHARS, playerId);
+        }
+        return ((side == 1) ? player1IdHash : player2IdHash) == playerHash
+               && memcmp(field, playerId.data(), ID_CHARS) == 0;
+    }
+
+    HistoricalMatch toHistoricalMatch() const {
+        string id1 = playerStoredId(1);
+        string name1 = playerName(1);
+        string id2 = playerStoredId(2);
+        string name2 = playerName(2);
+        HistoricalMatch hm(matchId, id1, name1, id2, name2);
+        if (winnerSide == 1) { hm.winnerId = id1; hm.winnerName = name1; }
+        else if (winnerSide == 2) { hm.winnerId = id2; hm.winnerName = name2; }
+        else hm.winnerId = "";
+        hm.recordType = static_cast<MatchRecordType>(recordType);
+        return hm;
+    }
+};
+static_assert(sizeof(MatchHistoryRecord) == 128, "MatchHistoryRecord must stay 128 bytes");
+
+struct MatchHistoryFileHeader {
+    static const unsigned int FORMAT_VERSION = 2; // 2: ID hashes (names 40 bytes)
+
+    char magic[4];                      // "TNMH"
+    unsigned int version;
+    unsigned int recordSize;
+    unsigned int reserved;
+    unsigned long long committedRecords;
+    char padding[40];                   // Keeps records 64-byte aligned in the mapping
+};
+static_assert(sizeof(MatchHistoryFileHeader) == 64, "MatchHistoryFileHeader must stay 64 bytes");
+
+class MatchHistoryFile {
+private:
+    FILE* file;
+    string filePath;
+    int syncEvery;
+    long long committedRecords; // Durable and visible to readers
+    long long writtenRecords;   // Handed to stdio, committed at the next batch
+
+    static bool seekTo(FILE* f, long long offset) {
+#ifdef _WIN32
+        return _fseeki64(f, offset, SEEK_SET) == 0;
+#else
+        return fseeko(f, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif
+    }
+
+    static bool syncToDisk(FILE* f) {
+        if (fflush(f) != 0) {
+            return false;
+        }
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return fsync(fileno(f)) == 0;
+#endif
+    }
+
+    static long long recordOffset(long long record) {
+        return static_cast<long long>(sizeof(MatchHistoryFileHeader)) + record * static_cast<long long>(sizeof(MatchHistoryRecord));
+    }
+
+    bool writeCommittedCount(long long count) {
+        unsigned long long value = static_cast<unsigned long long>(count);
+        return seekTo(file, offsetof(MatchHistoryFileHeader, committedRecords))
+            && fwrite(&value, sizeof(value), 1, file) == 1
+            && syncToDisk(file)
+            && seekTo(file, recordOffset(writtenRecords));
+    }
+
+    void closeFile() {
+        if (file != nullptr) {
+            flush();
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+public:
+    static const int DEFAULT_SYNC_EVERY = 64;
+
+    explicit MatchHistoryFile(int recordsPerSync = DEFAULT_SYNC_EVERY) :
+        file(nullptr), syncEvery(recordsPerSync > 0 ? recordsPerSync : 1), committedRecords(0), writtenRecords(0) {}
+
+    ~MatchHistoryFile() {
+        closeFile();
+    }
+
+    MatchHistoryFile(const MatchHistoryFile&) = delete;
+    MatchHistoryFile& operator=(const MatchHistoryFile&) = delete;
+
+    // Starts a new, empty history file at `path` (replacing any old one).
+    bool create(const string& path) {
+        closeFile();
+        file = fopen(path.c_str(), "w+b");
+        if (file == nullptr) {
+            cerr << "Error: Unable to create match history file: " << path << endl;
+            return false;
+        }
+        filePath = path;
+        committedRecords = writtenRecords = 0;
+        MatchHistoryFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, "TNMH", 4);
+        header.version = MatchHistoryFileHeader::FORMAT_VERSION;
+        header.recordSize = sizeof(MatchHistoryRecord);
+        if (fwrite(&header, sizeof(header), 1, file) != 1 || !syncToDisk(file)) {
+            cerr << "Error: Failed writing match history file: " << path << endl;
+            fclose(file);
+            file = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    // Reopens an existing history file to continue an event resumed from a checkpoint. Records
+    // past `keepRecords` (matches played after the checkpoint was taken) are discarded.
+    bool reopen(const string& path, long long keepRecords) {
+        closeFile();
+        file = fopen(path.c_str(), "r+b");
+        if (file == nullptr) {
+            return create(path);
+        }
+        filePath = path;
+        MatchHistoryFileHeader header;
+        if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, "TNMH", 4) != 0
+            || header.version != MatchHistoryFileHeader::FORMAT_VERSION
+            || header.recordSize != sizeof(MatchHistoryRecord)) {
+            cerr << "Error: " << path << " is not a match history file." << endl;
+            fclose(file);
+            file = nullptr;
+            return false;
+        }
+        long long saved = static_cast<long long>(header.committedRecords);
+        if (saved < keepRecords) {
+            cerr << "Warning: Match history file " << path << " holds " << saved << " of the " << keepRecords
+                 << " matches in the checkpoint. New matches are appended after them." << endl;
+            keepRecords = saved;
+        }
+        committedRecords = writtenRecords = keepRecords;
+        return writeCommittedCount(keepRecords);
+    }
+
+    bool isOpen() const { return file != nullptr; }
+    const string& getPath() const { return filePath; }
+    long long getCommittedRecords() const { return committedRecords; }
+
+    void append(const Match& match, MatchRecordType type) {
+        int winnerSide = (match.winner.idKey == match.player1.idKey) ? 1 : (match.winner.idKey == match.player2.idKey) ? 2 : 0;
+        appendRecord(match.matchId, match.player1.playerId, match.player1.playerName,
+                     match.player2.playerId, match.player2.playerName, winnerSide, type);
+    }
+    void append(const HistoricalMatch& match) {
+        append(match.matchId, match.player1Id, match.player1Name,
+               match.player2Id, match.player2Name, match.winnerId, match.recordType);
+    }
+
+    void append(int matchId, const string& player1Id, const string& player1Name,
+                const string& player2Id, const string& player2Name, const string& winnerId, MatchRecordType type) {
+        int winnerSide = (winnerId == player1Id) ? 1 : (winnerId == player2Id) ? 2 : 0;
+        appendRecord(matchId, player1Id, player1Name, player2Id, player2Name, winnerSide, type);
+    }
+
+    // winnerSide: 1 or 2, 0 if the winner is neither player.
+    void appendRecord(int matchId, const string& player1Id, const string& player1Name,
+                      const string& player2Id, const string& player2Name, int winnerSide, MatchRecordType type) {
+        if (file == nullptr) {
+            return;
+        }
+        MatchHistoryRecord record;
+        record.matchId = matchId;
+        record.winnerSide = static_cast<unsigned char>(winnerSide);
+        record.recordType = static_cast<unsigned char>(type);
+        record.reserved[0] = record.reserved[1] = 0;
+        record.player1IdHash = MatchHistoryRecord::idHash(player1Id);
+        record.player2IdHash = MatchHistoryRecord::idHash(player2Id);
+        MatchHistoryRecord::setField(record.player1Id, MatchHistoryRecord::ID_CHARS, player1Id);
+        MatchHistoryRecord::setField(record.player1Name, MatchHistoryRecord::NAME_CHARS, player1Name);
+        MatchHistoryRecord::setField(record.player2Id, MatchHistoryRecord::ID_CHARS, player2Id);
+        MatchHistoryRecord::setField(record.player2Name, MatchHistoryRecord::NAME_CHARS, player2Name);
+        if (fwrite(&record, sizeof(record), 1, file) != 1) {
+            cerr << "Warning: Failed appending match " << matchId << " to " << filePath << "." << endl;
+            return;
+        }
+        writtenRecords++;
+        if (writtenRecords - committedRecords >= syncEvery) {
+            flush();
+        }
+    }
+
+    // Makes every appended record durable and visible to readers.
+    bool flush() {
+        if (file == nullptr || writtenRecords == committedRecords) {
+            return file != nullptr;
+        }
+        TRACE_SPAN("MatchHistoryFile flush");
+        if (!syncToDisk(file) || !writeCommittedCount(writtenRecords)) {
+            cerr << "Warning: Failed syncing match history file " << filePath << "." << endl;
+            return false;
+        }
+        committedRecords = writtenRecords;
+        return true;
+    }
+};
+
+// --- MatchHistoryFileReader ---
+// Read-only view of a history file, memory-mapped so queries scan the records in place
+// without copying them to the heap. Safe to use while another process is still writing:
+// refresh() re-maps the file to pick up batches committed since the last call.
+class MatchHistoryFileReader {
+private:
+    const char* mapping;
+    size_t mappedBytes;
+    long long numRecords;
+    string filePath;
+#ifdef _WIN32
+    HANDLE fileHandle;
+    HANDLE mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+
+    void unmap() {
+#ifdef _WIN32
+        if (mapping != nullptr) UnmapViewOfFile(mapping);
+        if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+        if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+        mappingHandle = nullptr;
+        fileHandle = INVALID_HANDLE_VALUE;
+#else
+        if (mapping != nullptr) munmap(const_cast<char*>(mapping), mappedBytes);
+        if (fileDescriptor >= 0) ::close(fileDescriptor);
+        fileDescriptor = -1;
+#endif
+        mapping = nullptr;
+        mappedBytes = 0;
+        numRecords = 0;
+    }
+
+    // Maps the whole file as it is now; false if it cannot be opened or is empty.
+    bool mapFile() {
+#ifdef _WIN32
+        fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0) return false;
+        mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr) return false;
+        mapping = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        mappedBytes = static_cast<size_t>(size.QuadPart);
+#else
+        fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+        if (fileDescriptor < 0) return false;
+        struct stat info;
+        if (fstat(fileDescriptor, &info) != 0 || info.st_size == 0) return false;
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+        if (view == MAP_FAILED) return false;
+        mapping = static_cast<const char*>(view);
+        mappedBytes = static_cast<size_t>(info.st_size);
+#endif
+        return mapping != nullptr;
+    }
+
+    // Records visible to readers: the committed count, capped by what the mapping covers.
+    void readCommittedCount() {
+        unsigned long long committed;
+        memcpy(&committed, mapping + offsetof(MatchHistoryFileHeader, committedRecords), sizeof(committed));
+        long long mappedRecords = static_cast<long long>((mappedBytes - sizeof(MatchHistoryFileHeader)) / sizeof(MatchHistoryRecord));
+        numRecords = (static_cast<long long>(committed) < mappedRecords) ? static_cast<long long>(committed) : mappedRecords;
+    }
+
+public:
+    MatchHistoryFileReader() : mapping(nullptr), mappedBytes(0), numRecords(0),
+#ifdef _WIN32
+        fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr)
+#else
+        fileDescriptor(-1)
+#endif
+    {}
+
+    ~MatchHistoryFileReader() {
+        unmap();
+    }
+
+    MatchHistoryFileReader(const MatchHistoryFileReader&) = delete;
+    MatchHistoryFileReader& operator=(const MatchHistoryFileReader&) = delete;
+
+    bool open(const string& path) {
+        unmap();
+        filePath = path;
+        if (!mapFile()) {
+            cerr << "Error: Unable to map match history file: " << path << endl;
+            unmap();
+            return false;
+        }
+        MatchHistoryFileHeader header;
+        if (mappedBytes < sizeof(header)) {
+            cerr << "Error: " << path << " is not a match history file." << endl;
+            unmap();
+            return false;
+        }
+        memcpy(&header, mapping, sizeof(header));
+        if (memcmp(header.magic, "TNMH", 4) != 0) {
+            cerr << "Error: " << path << " is not a match history file." << endl;
+            unmap();
+            return false;
+        }
+        if (header.version != MatchHistoryFileHeader::FORMAT_VERSION || header.recordSize != sizeof(MatchHistoryRecord)) {
+            cerr << "Error: " << path << " uses match history format version " << header.version
+                 << "; this build reads version " << MatchHistoryFileHeader::FORMAT_VERSION << "." << endl;
+            unmap();
+            return false;
+        }
+        readCommittedCount();
+        return true;
+    }
+
+    // Picks up records committed since open() or the previous refresh().
+    bool refresh() {
+        return open(filePath);
+    }
+
+    long long getNumRecords() const { return numRecords; }
+
+    const MatchHistoryRecord& getRecord(long long index) const {
+        return *reinterpret_cast<const MatchHistoryRecord*>(mapping + sizeof(MatchHistoryFileHeader) + index * sizeof(MatchHistoryRecord));
+    }
+
+    // Index of the latest record for `matchId` (corrections come after the result), or -1.
+    long long findLatestRecordOfMatch(int matchId) const {
+        for (long long i = numRecords - 1; i >= 0; --i) {
+            if (getRecord(i).matchId == matchId) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Net wins and losses of one player over the whole file, with corrections applied the same
+    // way GameResultLogger applies them. Returns how many records involve the player.
+    long long tallyPlayer(const string& playerId, int& wins, int& losses) const {
+        wins = losses = 0;
+        long long involved = 0;
+        unsigned int playerHash = MatchHistoryRecord::idHash(playerId);
+        for (long long i = 0; i < numRecords; ++i) {
+            const MatchHistoryRecord& record = getRecord(i);
+            int side = record.hasPlayer(1, playerId, playerHash) ? 1 : record.hasPlayer(2, playerId, playerHash) ? 2 : 0;
+            if (side == 0) {
+                continue;
+            }
+            involved++;
+            bool isWinner = (record.winnerSide == side);
+            switch (static_cast<MatchRecordType>(record.recordType)) {
+                case MatchRecordType::Result:
+                    if (isWinner) wins++; else losses++;
+                    break;
+                case MatchRecordType::Overturned:
+                    if (isWinner) { wins++; losses--; } else { wins--; losses++; }
+                    break;
+                case MatchRecordType::Voided:
+                    if (isWinner) wins--; else losses--;
+                    break;
+            }
+        }
+        return involved;
+    }
+
+    // Prints every record involving `playerId`, oldest first; returns how many were printed.
+    long long printPlayerMatches(ostream& out, const string& playerId) const {
+        long long printed = 0;
+        unsigned int playerHash = MatchHistoryRecord::idHash(playerId);
+        for (long long i = 0; i < numRecords; ++i) {
+            const MatchHistoryRecord& record = getRecord(i);
+            if (record.hasPlayer(1, playerId, playerHash) || record.hasPlayer(2, playerId, playerHash)) {
+                out << "    " << ++printed << ". " << record.toHistoricalMatch() << endl;
+            }
+        }
+        return printed;
+    }
+};
+
+// --- GameResultLogger Class
+class GameResultLogger {
+private:
+    RecentItemsRing<int> recentMatchesLog;      // Rows of the last few results (bounded memory)
+    ColumnarMatchLog allMatchesChronologicalLog; // Every match, with a per-player row chain
+
+    DynamicArray<PlayerStats> playerStatsArray; // Grows past MAX_PLAYERS_UNIVERSAL for large events
+    int numTrackedPlayers;                               
+    PlayerIdIndex statsIndex;                   // Player key -> position in playerStatsArray
+    PlayerLeaderboard winsLeaderboard;          // Standings, updated with every recorded result
+    PlayerLeaderboard winRateLeaderboard;
+    PlayerLeaderboard ratingLeaderboard;
+
+    // Matches recorded since the last checkpoint (only kept while journaling is on)
+    bool journalEnabled;
+    DynamicArray<HistoricalMatch> unsavedMatches;
+
+    MatchHistoryFile* historyFile; // Optional on-disk copy of every recorded match (not owned)
+
+    // Whether the log's rows are still in match-ID order (rows appended by concurrent callers
+    // may not be; collectRowsInMatchIdOrder merges them when the log is read)
+    bool logInMatchIdOrder;
+    int highestLoggedMatchId;
+
+    // --- Concurrent recording ---
+    // recordMatchOutcome may be called from several threads. Wins and losses are updated at once
+    // under a lock stripe (player position % STAT_STRIPES). Everything else a result touches (the
+    // logs, ratings, leaderboards, journal and history file) is single-writer: callers stage their
+    // record in a shard and whichever caller holds `combining` applies the staged batch, merged
+    // into match-ID order. The caller that finds nothing staged applies its own record directly.
+    static const int STAT_STRIPES = 64;
+    static const int STAGING_SHARDS = 16;
+
+    struct alignas(64) StatStripe {
+        mutex lock;
+    };
+
+    struct StagedRecord {
+        HistoricalMatch match;
+        long long ticket; // Arrival order, breaks ties between corrections of the same match
+        int player1Stats; // Positions in playerStatsArray (-1 if untracked), found when staged
+        int player2Stats;
+        bool player1Won;
+        PlayerKey player1Key; // idKeys of the match's players, so the log need not encode the IDs
+        PlayerKey player2Key;
+        PlayerKey winnerKey;
+    };
+
+    struct alignas(64) StagingShard {
+        mutex lock;
+        DynamicArray<StagedRecord> records;
+    };
+
+    StatStripe statStripes[STAT_STRIPES];
+    StagingShard stagingShards[STAGING_SHARDS];
+    atomic<long long> nextTicket;
+    atomic<int> pendingRecords;  // Staged but not yet taken by a combiner
+    atomic<bool> combining;      // Held by the caller currently applying records
+    DynamicArray<StagedRecord> stagedBatch; // Combiner scratch space
+    DynamicArray<int> batchOrder;
+    DynamicArray<int> batchOrderScratch;
+
+    mutex& stripeOf(const PlayerStats& stats) {
+        return statStripes[(&stats - playerStatsArray.data()) % STAT_STRIPES].lock;
+    }
+
+    // Win/loss part of a result; safe to run from several threads at once.
+    void recordStats(PlayerStats* p1Stats, PlayerStats* p2Stats, bool player1Won, bool player2Won,
+                     const string& player1Id, const string& player1Name,
+                     const string& player2Id, const string& player2Name, MatchRecordType type) {
+        if (p1Stats != nullptr) {
+            lock_guard<mutex> guard(stripeOf(*p1Stats));
+            applyRecordToStats(*p1Stats, player1Won, type);
+        } else {
+            cerr << "Warning: Player " << player1Name << " (ID: " << player1Id 
+                 << ") not found in stats tracking array. Performance not updated." << endl;
+        }
+
+        if (p2Stats != nullptr) {
+            lock_guard<mutex> guard(stripeOf(*p2Stats));
+            applyRecordToStats(*p2Stats, player2Won, type);
+        } else {
+             cerr << "Warning: Player " << player2Name << " (ID: " << player2Id 
+                 << ") not found in stats tracking array. Performance not updated." << endl;
+        }
+    }
+
+    // Log, rating and standings part of a result (one writer at a time; see `combining`).
+    void appendToLogs(PlayerStats* p1Stats, PlayerStats* p2Stats, bool player1Won, int matchId,
+                      PlayerKey player1Key, const string& player1Id, const string& player1Name,
+                      PlayerKey player2Key, const string& player2Id, const string& player2Name,
+                      PlayerKey winnerKey, const string& winnerId, const string& winnerName, MatchRecordType type, int round, int group) {
+        // The log keeps each player's seeding rank from their stats entry (0 for untracked players)
+        int row = allMatchesChronologicalLog.append(matchId, player1Key, player1Id, player1Name, (p1Stats != nullptr) ? p1Stats->initialRank : 0,
+                                                    player2Key, player2Id, player2Name, (p2Stats != nullptr) ? p2Stats->initialRank : 0,
+                                                    winnerKey, winnerId, winnerName, type, round, group);
+        recentMatchesLog.push(row);
+        if (matchId < highestLoggedMatchId) {
+            logInMatchIdOrder = false;
+        } else {
+            highestLoggedMatchId = matchId;
+        }
+
+        if (p1Stats != nullptr && p2Stats != nullptr) { // Ratings need both sides
+            applyRecordToRatings(*p1Stats, *p2Stats, player1Won, type);
+        }
+        if (p1Stats != nullptr) updateStandings(*p1Stats);
+        if (p2Stats != nullptr) updateStandings(*p2Stats);
+    }
+
+    // Adds a finished match to both logs and updates both players' win/loss records.
+    void appendToHistory(const HistoricalMatch& histMatch, bool journal) {
+        if (journal && journalEnabled) {
+            unsavedMatches.pushBack(histMatch);
+        }
+        PlayerStats* p1Stats = findPlayerStatsInArray(histMatch.player1Id);
+        PlayerStats* p2Stats = findPlayerStatsInArray(histMatch.player2Id);
+        bool player1Won = histMatch.winnerId == histMatch.player1Id; // Restores only; live results compare keys
+        recordStats(p1Stats, p2Stats, player1Won, histMatch.winnerId == histMatch.player2Id, histMatch.player1Id,
+                    histMatch.player1Name, histMatch.player2Id, histMatch.player2Name, histMatch.recordType);
+        appendToLogs(p1Stats, p2Stats, player1Won, histMatch.matchId,
+                     PlayerIdCodec::encode(histMatch.player1Id), histMatch.player1Id, histMatch.player1Name,
+                     PlayerIdCodec::encode(histMatch.player2Id), histMatch.player2Id, histMatch.player2Name,
+                     PlayerIdCodec::encode(histMatch.winnerId), histMatch.winnerId, histMatch.winnerName,
+                     histMatch.recordType, histMatch.round, histMatch.group);
+    }
+
+    void stageRecord(const HistoricalMatch& histMatch, const Match& completedMatch, PlayerStats* p1Stats, PlayerStats* p2Stats, bool player1Won) {
+        StagingShard& shard = stagingShards[hash<thread::id>()(this_thread::get_id()) % STAGING_SHARDS];
+        {
+            lock_guard<mutex> guard(shard.lock);
+            StagedRecord staged;
+            staged.match = histMatch;
+            staged.ticket = nextTicket.fetch_add(1);
+            staged.player1Stats = (p1Stats != nullptr) ? static_cast<int>(p1Stats - playerStatsArray.data()) : -1;
+            staged.player2Stats = (p2Stats != nullptr) ? static_cast<int>(p2Stats - playerStatsArray.data()) : -1;
+            staged.player1Won = player1Won;
+            staged.player1Key = completedMatch.player1.idKey;
+            staged.player2Key = completedMatch.player2.idKey;
+            staged.winnerKey = completedMatch.winner.idKey;
+            shard.records.pushBack(staged);
+        }
+        pendingRecords.fetch_add(1);
+    }
+
+    // Stable bottom-up merge sort of `order` (indices) by `before`; `scratch` is reused between calls.
+    template <typename Before>
+    static void mergeSortIndices(DynamicArray<int>& order, DynamicArray<int>& scratch, Before before) {
+        int n = order.size();
+        scratch.clear();
+        for (int i = 0; i < n; ++i) {
+            scratch.pushBack(order[i]);
+        }
+        for (int width = 1; width < n; width *= 2) {
+            for (int left = 0; left < n; left += 2 * width) {
+                int mid = (left + width < n) ? left + width : n;
+                int right = (left + 2 * width < n) ? left + 2 * width : n;
+                int i = left, j = mid, k = left;
+                while (i < mid && j < right) {
+                    scratch[k++] = before(order[j], order[i]) ? order[j++] : order[i++];
+                }
+                while (i < mid) scratch[k++] = order[i++];
+                while (j < right) scratch[k++] = order[j++];
+            }
+            order.swap(scratch);
+        }
+    }
+
+    // Takes every staged record and applies the batch in match-ID order (combiner only).
+    void applyStagedRecords() {
+        TRACE_SPAN("GameResultLogger applyStagedRecords");
+        stagedBatch.clear();
+        for (int s = 0; s < STAGING_SHARDS; ++s) {
+            StagingShard& shard = stagingShards[s];
+            lock_guard<mutex> guard(shard.lock);
+            for (int i = 0; i < shard.records.size(); ++i) {
+                stagedBatch.pushBack(shard.records[i]);
+            }
+            pendingRecords.fetch_sub(shard.records.size());
+            shard.records.clear();
+        }
+        batchOrder.clear();
+        for (int i = 0; i < stagedBatch.size(); ++i) {
+            batchOrder.pushBack(i);
+        }
+        mergeSortIndices(batchOrder, batchOrderScratch, [this](int a, int b) { // By match ID, then arrival
+            const StagedRecord& first = stagedBatch[a];
+            const StagedRecord& second = stagedBatch[b];
+            if (first.match.matchId != second.match.matchId) {
+                return first.match.matchId < second.match.matchId;
+            }
+            return first.ticket < second.ticket;
+        });
+        for (int i = 0; i < batchOrder.size(); ++i) {
+            const StagedRecord& staged = stagedBatch[batchOrder[i]];
+            const HistoricalMatch& histMatch = staged.match;
+            if (journalEnabled) {
+                unsavedMatches.pushBack(histMatch);
+            }
+            appendToLogs((staged.player1Stats >= 0) ? &playerStatsArray[staged.player1Stats] : nullptr,
+                         (staged.player2Stats >= 0) ? &playerStatsArray[staged.player2Stats] : nullptr,
+                         staged.player1Won, histMatch.matchId,
+                         staged.player1Key, histMatch.player1Id, histMatch.player1Name,
+                         staged.player2Key, histMatch.player2Id, histMatch.player2Name,
+                         staged.winnerKey, histMatch.winnerId, histMatch.winnerName, histMatch.recordType,
+                         histMatch.round, histMatch.group);
+            if (historyFile != nullptr) {
+                historyFile->append(histMatch);
+            }
+        }
+    }
+
+    // Called holding `combining`: applies whatever is staged, then releases it. A record staged
+    // while this caller was releasing is picked up here, so nothing is left behind once every
+    // recordMatchOutcome call has returned.
+    void combineStagedRecords() {
+        for (;;) {
+            if (pendingRecords.load() > 0) {
+                applyStagedRecords();
+            }
+            combining.store(false);
+            if (pendingRecords.load() == 0 || combining.exchange(true)) {
+                return;
+            }
+        }
+    }
+
+    // Win/loss delta of one log entry for one of its two players.
+    static void applyRecordToStats(PlayerStats& stats, bool isWinner, MatchRecordType type) {
+        switch (type) {
+            case MatchRecordType::Result:
+                if (isWinner) stats.recordWin(); else stats.recordLoss();
+                break;
+            case MatchRecordType::Overturned: // The loss becomes a win and vice versa
+                if (isWinner) { stats.undoLoss(); stats.recordWin(); }
+                else { stats.undoWin(); stats.recordLoss(); }
+                break;
+            case MatchRecordType::Voided:
+                if (isWinner) stats.undoWin(); else stats.undoLoss();
+                break;
+        }
+    }
+
+    // EloRating exchange of one log entry (see EloRating for how corrections are rated).
+    static void applyRecordToRatings(PlayerStats& player1, PlayerStats& player2, bool player1Won, MatchRecordType type) {
+        PlayerStats& winner = player1Won ? player1 : player2;
+        PlayerStats& loser = player1Won ? player2 : player1;
+        double shift = 0.0;
+        switch (type) {
+            case MatchRecordType::Result:
+                shift = EloRating::winShift(winner.rating, loser.rating);
+                break;
+            case MatchRecordType::Overturned: // winner is the new winner
+                shift = EloRating::K_FACTOR;
+                break;
+            case MatchRecordType::Voided:     // winner is the withdrawn winner
+                shift = -EloRating::winShift(winner.rating, loser.rating);
+                break;
+        }
+        winner.rating += shift;
+        loser.rating -= shift;
+    }
+
+    // Helper to find a player's stats in the array (string playerId), O(1) through statsIndex
+    PlayerStats* findPlayerStatsInArray(const string& playerId) { 
+        METRICS_ADD(StatsLookups, 1);
+        int position = statsIndex.find(playerId);
+        return (position >= 0) ? &playerStatsArray[position] : nullptr;
+    }
+    // Const version for read-only access
+    const PlayerStats* findPlayerStatsInArray(const string& playerId) const { 
+        METRICS_ADD(StatsLookups, 1);
+        int position = statsIndex.find(playerId);
+        return (position >= 0) ? &playerStatsArray[position] : nullptr;
+    }
+    // Same, by a Player's idKey (what recorded results use)
+    PlayerStats* findPlayerStatsInArray(PlayerKey playerKey) {
+        METRICS_ADD(StatsLookups, 1);
+        int position = statsIndex.find(playerKey);
+        return (position >= 0) ? &playerStatsArray[position] : nullptr;
+    }
+
+    void addTrackedPlayer(PlayerStats stats) {
+        playerStatsArray.pushBack(std::move(stats));
+        const PlayerStats& added = playerStatsArray[numTrackedPlayers];
+        statsIndex.insert(PlayerIdCodec::encode(added.playerId), numTrackedPlayers);
+        winsLeaderboard.addPlayer(numTrackedPlayers, added);
+        winRateLeaderboard.addPlayer(numTrackedPlayers, added);
+        ratingLeaderboard.addPlayer(numTrackedPlayers, added);
+        numTrackedPlayers++;
+    }
+
+    // Re-places a player on every leaderboard after their record or rating changed.
+    void updateStandings(const PlayerStats& stats) {
+        int position = static_cast<int>(&stats - playerStatsArray.data());
+        lock_guard<mutex> guard(statStripes[position % STAT_STRIPES].lock); // Wins/losses may be changing
+        winsLeaderboard.updatePlayer(position, stats);
+        winRateLeaderboard.updatePlayer(position, stats);
+        ratingLeaderboard.updatePlayer(position, stats);
+    }
+
+    const PlayerLeaderboard& leaderboardFor(LeaderboardOrder order) const {
+        switch (order) {
+            case LeaderboardOrder::WinRate: return winRateLeaderboard;
+            case LeaderboardOrder::Rating: return ratingLeaderboard;
+            default: return winsLeaderboard;
+        }
+    }
+
+public:
+    static const int DEFAULT_RECENT_MATCHES = 256;
+
+    // `recentMatchesCapacity` bounds how many results displayRecentMatches can show.
+    explicit GameResultLogger(int recentMatchesCapacity = DEFAULT_RECENT_MATCHES) :
+        recentMatchesLog(recentMatchesCapacity), playerStatsArray(MAX_PLAYERS_UNIVERSAL), numTrackedPlayers(0),
+        statsIndex(MAX_PLAYERS_UNIVERSAL), winsLeaderboard(LeaderboardOrder::Wins), winRateLeaderboard(LeaderboardOrder::WinRate),
+        ratingLeaderboard(LeaderboardOrder::Rating),
+        journalEnabled(false), historyFile(nullptr), logInMatchIdOrder(true), highestLoggedMatchId(0), nextTicket(0), pendingRecords(0), combining(false) {} 
+
+    // Pre-sizes stats storage for large events (optional).
+    void reservePlayers(int expectedPlayers) {
+        playerStatsArray.reserve(expectedPlayers);
+    }
+
+    // Initializes a stats entry for a new player.
+    void initializePlayerForStats(const Player& player) {
+        if (findPlayerStatsInArray(player.playerId) == nullptr) { 
+            addTrackedPlayer(PlayerStats(player.playerId, player.playerName, player.ranking));
+        } 
+    }
+
+    // Records the outcome of a completed match. Corrections pass the Overturned or Voided type
+    // (see MatchRecordType); they are appended to the logs and adjust the two players' stats.
+    // Safe to call from several threads once every player is registered (see "Concurrent
+    // recording"); the reporting methods must not run until those calls have returned.
+    void recordMatchOutcome(const Match& completedMatch, MatchRecordType type = MatchRecordType::Result) {
+        if (!completedMatch.played) {
+            return;
+        }
+        if (completedMatch.winner.playerId == "" || completedMatch.winner.playerName == "N/A") { 
+            cerr << "Warning: Match (ID: " << completedMatch.matchId 
+                 << ") outcome is unclear (invalid winner). Performance log update skipped." << endl;
+            return; 
+        }
+        METRICS_ADD(MatchesRecorded, 1);
+
+        PlayerStats* p1Stats = findPlayerStatsInArray(completedMatch.player1.idKey);
+        PlayerStats* p2Stats = findPlayerStatsInArray(completedMatch.player2.idKey);
+        bool player1Won = completedMatch.winner.idKey == completedMatch.player1.idKey;
+        recordStats(p1Stats, p2Stats, player1Won, completedMatch.winner.idKey == completedMatch.player2.idKey,
+                    completedMatch.player1.playerId, completedMatch.player1.playerName,
+                    completedMatch.player2.playerId, completedMatch.player2.playerName, type);
+
+        if (pendingRecords.load() == 0 && !combining.exchange(true)) { // Uncontended: no copy needed
+            if (journalEnabled) { // Checkpoints need the full record; otherwise nothing is copied
+                unsavedMatches.pushBack(HistoricalMatch(
+                    completedMatch.matchId,
+                    completedMatch.player1.playerId, completedMatch.player1.playerName, 
+                    completedMatch.player2.playerId, completedMatch.player2.playerName, 
+                    completedMatch.winner.playerId, completedMatch.winner.playerName,
+                    type, completedMatch.round, completedMatch.group
+                ));
+            }
+            appendToLogs(p1Stats, p2Stats, player1Won, completedMatch.matchId,
+                         completedMatch.player1.idKey, completedMatch.player1.playerId, completedMatch.player1.playerName,
+                         completedMatch.player2.idKey, completedMatch.player2.playerId, completedMatch.player2.playerName,
+                         completedMatch.winner.idKey, completedMatch.winner.playerId, completedMatch.winner.playerName, type,
+                         completedMatch.round, completedMatch.group);
+            if (historyFile != nullptr) {
+                historyFile->append(completedMatch, type);
+            }
+            combineStagedRecords();
+            return;
+        }
+
+        stageRecord(HistoricalMatch(
+            completedMatch.matchId,
+            completedMatch.player1.playerId, completedMatch.player1.playerName, 
+            completedMatch.player2.playerId, completedMatch.player2.playerName, 
+            completedMatch.winner.playerId, completedMatch.winner.playerName,
+            type, completedMatch.round, completedMatch.group
+        ), completedMatch, p1Stats, p2Stats, player1Won);
+        if (!combining.exchange(true)) {
+            combineStagedRecords();
+        }
+    }
+
+    // Every match recorded from now on is also appended to `file` (nullptr to stop). Matches
+    // restored from a checkpoint are not, since the file written before the crash has them.
+    void setHistoryFile(MatchHistoryFile* file) {
+        historyFile = file;
+    }
+
+    // --- Checkpoint support ---
+    // While journaling is on, every recorded match is also kept until the next checkpoint
+    // takes it, so a checkpoint only writes the matches played since the previous one.
+    void setJournalEnabled(bool enabled) {
+        journalEnabled = enabled;
+        unsavedMatches.clear();
+    }
+    const DynamicArray<HistoricalMatch>& getUnsavedMatches() const {
+        return unsavedMatches;
+    }
+    void clearUnsavedMatches() {
+        unsavedMatches.clear();
+    }
+
+    int getNumTrackedPlayers() const {
+        return numTrackedPlayers;
+    }
+    const PlayerStats& getTrackedPlayerStats(int index) const {
+        return playerStatsArray[index];
+    }
+    // Stats of one tracked player, or nullptr if the player is not tracked.
+    const PlayerStats* findPlayerStats(const string& playerId) const {
+        return findPlayerStatsInArray(playerId);
+    }
+
+    // Registers a stats entry exactly as saved (used when restoring a checkpoint).
+    void restoreTrackedPlayer(const PlayerStats& stats) {
+        addTrackedPlayer(stats);
+    }
+
+    // --- Ratings and seeding ---
+    // Current EloRating of a player (EloRating::INITIAL if not tracked).
+    double getRating(const string& playerId) const {
+        const PlayerStats* stats = findPlayerStatsInArray(playerId);
+        return (stats != nullptr) ? stats->rating : EloRating::INITIAL;
+    }
+
+    // Starts a player from a rating carried over from earlier events (see GlickoSeasonRater).
+    // Call before the player's first match; returns false if the player is not tracked.
+    bool setStartingRating(const string& playerId, double rating) {
+        PlayerStats* stats = findPlayerStatsInArray(playerId);
+        if (stats == nullptr) {
+            return false;
+        }
+        stats->rating = stats->startingRating = rating;
+        updateStandings(*stats);
+        return true;
+    }
+
+    // Records the seed a player was given when the field was re-seeded (before any matches,
+    // so the match log's rank columns see the new seed).
+    void setSeedRank(const string& playerId, int rank) {
+        PlayerStats* stats = findPlayerStatsInArray(playerId);
+        if (stats != nullptr) {
+            stats->initialRank = rank;
+        }
+    }
+
+    // Replays a saved match into the logs and stats. With `journal` set it is also queued for
+    // the next checkpoint (used when a resumed run rewrites its checkpoint file).
+    void restoreMatchRecord(const HistoricalMatch& histMatch, bool journal) {
+        appendToHistory(histMatch, journal);
+    }
+
+    void displayRecentMatches(int numToDisplay = 5) const {
+        int actualDisplayCount = numToDisplay;
+        if (recentMatchesLog.size() < actualDisplayCount) {
+            actualDisplayCount = recentMatchesLog.size();
+        }
+        cout << "\n--- Recent Match Results (Last " << actualDisplayCount << " / " << recentMatchesLog.size() << " Total Recent) ---" << endl;
+        
+        if (recentMatchesLog.isEmpty()) {
+            cout << "No match results have been recorded yet." << endl;
+        } else {
+            for (int k = 0; k < actualDisplayCount; ++k) {
+                allMatchesChronologicalLog.printRow(cout, recentMatchesLog.fromNewest(k)) << endl; 
+            }
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+
+    void displayAllRecordedMatches() const {
+        cout << "\n--- All Recorded Matches (" << allMatchesChronologicalLog.size() << " Total) ---" << endl;
+        if (allMatchesChronologicalLog.isEmpty()) {
+            cout << "No matches have been recorded in the chronological log." << endl;
+        } else {
+            DynamicArray<int> rows; // Only filled when the rows need merging into match-ID order
+            if (!logInMatchIdOrder) {
+                collectRowsInMatchIdOrder(rows);
+            }
+            for (int i = 0; i < allMatchesChronologicalLog.size(); ++i) {
+                cout << (i + 1) << ". ";
+                allMatchesChronologicalLog.printRow(cout, logInMatchIdOrder ? i : rows[i]) << endl;
+            }
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+
+    // Newest-first access to the recent results ring (k = 0 is the latest match).
+    int getNumRecentMatches() const {
+        return recentMatchesLog.size();
+    }
+    HistoricalMatch getRecentMatch(int k) const {
+        return allMatchesChronologicalLog.getMatch(recentMatchesLog.fromNewest(k));
+    }
+
+    int getNumLoggedMatches() const {
+        return allMatchesChronologicalLog.size();
+    }
+
+    // A row of the chronological log (0 = first match logged).
+    HistoricalMatch getLoggedMatch(int row) const {
+        return allMatchesChronologicalLog.getMatch(row);
+    }
+
+    // Appends every row of the chronological log to `rows` in match-ID order. A correction stays
+    // after the result it corrects. Rows recorded by a single caller are already in order and
+    // are copied as they are; otherwise the rows are merge sorted by match ID.
+    void collectRowsInMatchIdOrder(DynamicArray<int>& rows) const {
+        DynamicArray<int> order(allMatchesChronologicalLog.size());
+        for (int row = 0; row < allMatchesChronologicalLog.size(); ++row) {
+            order.pushBack(row);
+        }
+        if (!logInMatchIdOrder) {
+            const ColumnarMatchLog& log = allMatchesChronologicalLog;
+            DynamicArray<int> scratch(order.size());
+            mergeSortIndices(order, scratch, [&log](int a, int b) {
+                const int CHUNK_MASK = ColumnarMatchLog::CHUNK_ROWS - 1;
+                return log.getChunk(a >> ColumnarMatchLog::CHUNK_SHIFT).matchId[a & CHUNK_MASK]
+                     < log.getChunk(b >> ColumnarMatchLog::CHUNK_SHIFT).matchId[b & CHUNK_MASK];
+            });
+        }
+        for (int i = 0; i < order.size(); ++i) {
+            rows.pushBack(order[i]);
+        }
+    }
+
+    // Column access for scans over the whole history.
+    const ColumnarMatchLog& getMatchLog() const {
+        return allMatchesChronologicalLog;
+    }
+
+    // Appends the chronological log rows involving one player to `rows`, oldest first, and
+    // returns how many were added. Runs in time proportional to that player's own matches.
+    int collectPlayerMatchRows(const string& playerId, DynamicArray<int>& rows) const {
+        int player = allMatchesChronologicalLog.findPlayer(playerId);
+        if (player < 0) {
+            return 0;
+        }
+        for (int row = allMatchesChronologicalLog.getFirstRowOfPlayer(player); row >= 0;
+             row = allMatchesChronologicalLog.getNextRowOfPlayer(row, player)) {
+            rows.pushBack(row);
+        }
+        return allMatchesChronologicalLog.getPlayerMatchCount(player);
+    }
+
+    void displaySinglePlayerPerformance(string playerId) const { 
+        cout << "\n--- Full Performance Record for Player ID: " << playerId << " ---" << endl;
+        const PlayerStats* playerStats = findPlayerStatsInArray(playerId); 
+        if (playerStats != nullptr) { 
+            cout << *playerStats << endl; 
+            cout << "  Standing: #" << getStanding(playerId, LeaderboardOrder::Wins) << " by wins, #"
+                 << getStanding(playerId, LeaderboardOrder::WinRate) << " by win rate, #"
+                 << getStanding(playerId, LeaderboardOrder::Rating) << " by rating (of " << numTrackedPlayers << ")" << endl;
+            
+            // List all matches involving this player, following their chain through the log
+            cout << "  Matches involving " << playerStats->playerName << ":" << endl;
+            bool foundPlayerMatch = false;
+            int matchCounter = 1;
+            int player = allMatchesChronologicalLog.findPlayer(playerId);
+            for (int row = (player >= 0) ? allMatchesChronologicalLog.getFirstRowOfPlayer(player) : -1; row >= 0;
+                 row = allMatchesChronologicalLog.getNextRowOfPlayer(row, player)) {
+                cout << "    " << matchCounter++ << ". ";
+                allMatchesChronologicalLog.printRow(cout, row) << endl;
+                foundPlayerMatch = true;
+            }
+            if(!foundPlayerMatch) {
+                cout << "    No specific match records found in the log for this player." << endl;
+            }
+        } else {
+            cout << "Player with ID " << playerId << " not found or no stats recorded for them." << endl;
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+
+    // --- Leaderboards ---
+    // Place of a player (1 = leader, ties share a place), or 0 if the player is not tracked.
+    int getStanding(const string& playerId, LeaderboardOrder order) const {
+        int position = statsIndex.find(playerId);
+        return (position >= 0) ? leaderboardFor(order).placeOf(position) : 0;
+    }
+
+    // Appends the stats positions (see getTrackedPlayerStats) of the top `count` players.
+    void collectLeaders(int count, LeaderboardOrder order, DynamicArray<int>& positions) const {
+        leaderboardFor(order).collectTop(count, positions);
+    }
+
+    void displayLeaderboard(int count, LeaderboardOrder order) const {
+        DynamicArray<int> leaders;
+        collectLeaders(count, order, leaders);
+        const char* orderName = (order == LeaderboardOrder::WinRate) ? "Win Rate"
+                              : (order == LeaderboardOrder::Rating) ? "Rating" : "Wins";
+        cout << "\n--- Leaderboard by " << orderName << " (Top " << leaders.size() << " of " << numTrackedPlayers << ") ---" << endl;
+        if (leaders.isEmpty()) {
+            cout << "No player performance data available." << endl;
+        }
+        const PlayerLeaderboard& board = leaderboardFor(order);
+        int place = 1;
+        for (int i = 0; i < leaders.size(); ++i) {
+            if (i > 0 && !board.tied(leaders[i - 1], leaders[i])) {
+                place = i + 1;
+            }
+            const PlayerStats& stats = playerStatsArray[leaders[i]];
+            cout << place << ". " << stats.playerName << " (ID: " << stats.playerId << ") | Wins: " << stats.wins
+                 << ", Losses: " << stats.losses;
+            if (stats.totalMatchesPlayed() > 0) {
+                cout << ", Win Rate: " << (100 * stats.wins / stats.totalMatchesPlayed()) << "%";
+            }
+            cout << ", Rating: " << lround(stats.rating) << endl;
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+
+    void displayAllPlayersPerformanceSummary() const {
+        cout << "\n--- All Player Performance Summaries (" << numTrackedPlayers << " Players Tracked) ---" << endl;
+        if (numTrackedPlayers == 0) { // Typo fix: numTrackers -> numTrackedPlayers
+            cout << "No player performance data available." << endl;
+        } else {
+            for (int i = 0; i < numTrackedPlayers; ++i) {
+                cout << playerStatsArray[i] << endl;
+            }
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+};
+
+// --- MatchQueryEngine ---
+// Secondary indexes and analytic scans over a match log (GameResultLogger::getMatchLog()). Indexing is
+// incremental: every query first indexes the rows logged since the previous one, so an
+// engine can stay attached to a running event.
+//   - Player pairs: hash table from the unordered pair of player-table indices to a chain of
+//     that pair's rows, so a head-to-head costs time proportional to their meetings.
+//   - Rounds and groups: one row chain per main bracket round, per group-stage round and
+//     per group.
+// Aggregates (upsets, tier against tier) are sequential passes over per-row winner and loser
+// rank columns the engine fills while indexing, next to the log's record type column.
+// Corrections count the way the stats do: an overturn moves the result to the other player
+// and a void withdraws it.
+class MatchQueryEngine {
+public:
+    static const int MAX_TIERS = 16; // Ranks past the last tier are folded into it
+
+    struct HeadToHead {
+        int winsFirst;  // Net wins of the first player over the second
+        int winsSecond;
+        int records;    // Log rows between the two, corrections included
+    };
+
+    struct TierTable {
+        int numTiers;                         // Highest tier seen + 1
+        long long wins[MAX_TIERS][MAX_TIERS]; // wins[a][b]: net wins of tier a players over tier b players
+    };
+
+private:
+    struct RowChain {
+        int firstRow; // -1 while empty
+        int lastRow;
+        int count;
+    };
+
+    struct PairEntry {
+        unsigned long long key; // Lower player index << 32 | higher player index
+        RowChain rows;
+    };
+
+    static const int RESULT = static_cast<int>(MatchRecordType::Result);
+    static const int OVERTURNED = static_cast<int>(MatchRecordType::Overturned);
+    static const int VOIDED = static_cast<int>(MatchRecordType::Voided);
+
+    const ColumnarMatchLog& log;
+    int indexedRows;
+    DynamicArray<int> winnerRanks;          // Per row, 0 when unranked or there is no winner
+    DynamicArray<int> loserRanks;
+
+    DynamicArray<PairEntry> pairs;
+    int* pairSlots;                         // Positions in `pairs`, -1 for empty (at most half full)
+    unsigned int pairMask;
+    DynamicArray<int> nextSamePair;         // Per row: next row of the same pair, -1 at the end
+
+    DynamicArray<RowChain> bracketRounds;   // Indexed by round number
+    DynamicArray<RowChain> groupStageRounds;
+    DynamicArray<RowChain> groups;          // Indexed by group number
+    DynamicArray<int> nextSameRound;        // Per row, within its bracket or group-stage round
+    DynamicArray<int> nextSameGroup;        // Per row, -1 for bracket matches
+
+    static unsigned long long pairKey(int playerA, int playerB) {
+        unsigned long long low = static_cast<unsigned int>(playerA < playerB ? playerA : playerB);
+        unsigned long long high = static_cast<unsigned int>(playerA < playerB ? playerB : playerA);
+        return (low << 32) | high;
+    }
+
+    static unsigned long long hashKey(unsigned long long key) { // splitmix64 finalizer
+        key ^= key >> 30;
+        key *= 0xBF58476D1CE4E5B9ULL;
+        key ^= key >> 27;
+        key *= 0x94D049BB133111EBULL;
+        return key ^ (key >> 31);
+    }
+
+    void allocatePairSlots(unsigned int tableSize) {
+        pairSlots = new int[tableSize];
+        pairMask = tableSize - 1;
+        for (unsigned int i = 0; i < tableSize; ++i) {
+            pairSlots[i] = -1;
+        }
+    }
+
+    void placePair(int position) {
+        unsigned int bucket = static_cast<unsigned int>(hashKey(pairs[position].key)) & pairMask;
+        while (pairSlots[bucket] >= 0) {
+            bucket = (bucket + 1) & pairMask;
+        }
+        pairSlots[bucket] = position;
+    }
+
+    int findPair(unsigned long long key) const {
+        unsigned int bucket = static_cast<unsigned int>(hashKey(key)) & pairMask;
+        while (pairSlots[bucket] >= 0) {
+            if (pairs[pairSlots[bucket]].key == key) {
+                return pairSlots[bucket];
+            }
+            bucket = (bucket + 1) & pairMask;
+        }
+        return -1;
+    }
+
+    int findOrAddPair(unsigned long long key) {
+        int position = findPair(key);
+        if (position >= 0) {
+            return position;
+        }
+        if (static_cast<unsigned int>(pairs.size() + 1) * 2 > pairMask + 1) {
+            unsigned int newSize = (pairMask + 1) * 2;
+            delete[] pairSlots;
+            allocatePairSlots(newSize);
+            for (int p = 0; p < pairs.size(); ++p) {
+                placePair(p);
+            }
+        }
+        PairEntry entry = {key, {-1, -1, 0}};
+        pairs.pushBack(entry);
+        placePair(pairs.size() - 1);
+        return pairs.size() - 1;
+    }
+
+    static void appendToChain(RowChain& chain, int row, DynamicArray<int>& links) {
+        if (chain.lastRow < 0) {
+            chain.firstRow = row;
+        } else {
+            links[chain.lastRow] = row;
+        }
+        chain.lastRow = row;
+        chain.count++;
+    }
+
+    static RowChain& chainFor(DynamicArray<RowChain>& chains, int key) {
+        RowChain empty = {-1, -1, 0};
+        while (chains.size() <= key) {
+            chains.pushBack(empty);
+        }
+        return chains[key];
+    }
+
+    static int collectChain(const DynamicArray<RowChain>& chains, int key, const DynamicArray<int>& links, DynamicArray<int>& rows) {
+        if (key < 0 || key >= chains.size()) {
+            return 0;
+        }
+        for (int row = chains[key].firstRow; row >= 0; row = links[row]) {
+            rows.pushBack(row);
+        }
+        return chains[key].count;
+    }
+
+    int tierOf(int rank, int tierWidth) const {
+        int tier = (rank - 1) / tierWidth;
+        return (tier < MAX_TIERS) ? tier : MAX_TIERS - 1;
+    }
+
+    static string tierLabel(int tier, int tierWidth) {
+        string label = "Ranks " + to_string(tier * tierWidth + 1);
+        return (tier == MAX_TIERS - 1) ? label + "+" : label + "-" + to_string((tier + 1) * tierWidth);
+    }
+
+    void printRows(const DynamicArray<int>& rows) const {
+        for (int i = 0; i < rows.size(); ++i) {
+            cout << "  " << (i + 1) << ". ";
+            log.printRow(cout, rows[i]) << endl;
+        }
+    }
+
+public:
+    explicit MatchQueryEngine(const ColumnarMatchLog& matchLog) :
+        log(matchLog), indexedRows(0), pairSlots(nullptr), pairMask(0) {
+        allocatePairSlots(64);
+    }
+
+    ~MatchQueryEngine() {
+        delete[] pairSlots;
+    }
+
+    MatchQueryEngine(const MatchQueryEngine&) = delete;
+    MatchQueryEngine& operator=(const MatchQueryEngine&) = delete;
+
+    // Indexes the rows logged since the last call. Every query calls it first.
+    void update() {
+        for (int row = indexedRows; row < log.size(); ++row) {
+            const ColumnarMatchLog::Chunk& chunk = log.getChunk(row >> ColumnarMatchLog::CHUNK_SHIFT);
+            int offset = row & (ColumnarMatchLog::CHUNK_ROWS - 1);
+            nextSamePair.pushBack(-1);
+            nextSameRound.pushBack(-1);
+            nextSameGroup.pushBack(-1);
+
+            int winner = chunk.winner[offset];
+            int loser = (winner == chunk.player1[offset]) ? chunk.player2[offset] : chunk.player1[offset];
+            winnerRanks.pushBack((winner >= 0) ? log.getPlayerRank(winner) : 0);
+            loserRanks.pushBack((winner >= 0) ? log.getPlayerRank(loser) : 0);
+
+            int pair = findOrAddPair(pairKey(chunk.player1[offset], chunk.player2[offset]));
+            appendToChain(pairs[pair].rows, row, nextSamePair);
+
+            int round = chunk.round[offset];
+            int group = chunk.group[offset];
+            if (round >= 0) {
+                appendToChain(chainFor(group > 0 ? groupStageRounds : bracketRounds, round), row, nextSameRound);
+            }
+            if (group > 0) {
+                appendToChain(chainFor(groups, group), row, nextSameGroup);
+            }
+        }
+        indexedRows = log.size();
+    }
+
+    int getIndexedRows() const { return indexedRows; }
+    int getNumPairs() const { return pairs.size(); }
+
+    // Net record between two players. Returns false if either has never been logged.
+    // With `rows` set, their log rows are appended to it in order.
+    bool headToHead(const string& firstId, const string& secondId, HeadToHead& result, DynamicArray<int>* rows = nullptr) {
+        update();
+        result.winsFirst = result.winsSecond = result.records = 0;
+        int first = log.findPlayer(firstId);
+        int second = log.findPlayer(secondId);
+        if (first < 0 || second < 0) {
+            return false;
+        }
+        int pair = findPair(pairKey(first, second));
+        if (pair < 0) {
+            return true;
+        }
+        for (int row = pairs[pair].rows.firstRow; row >= 0; row = nextSamePair[row]) {
+            const ColumnarMatchLog::Chunk& chunk = log.getChunk(row >> ColumnarMatchLog::CHUNK_SHIFT);
+            int offset = row & (ColumnarMatchLog::CHUNK_ROWS - 1);
+            int winner = chunk.winner[offset];
+            if (winner == first || winner == second) {
+                int& winnerWins = (winner == first) ? result.winsFirst : result.winsSecond;
+                int& otherWins = (winner == first) ? result.winsSecond : result.winsFirst;
+                switch (chunk.recordType[offset]) {
+                    case RESULT: winnerWins++; break;
+                    case OVERTURNED: winnerWins++; otherWins--; break;
+                    case VOIDED: winnerWins--; break;
+                }
+            }
+            result.records++;
+            if (rows != nullptr) {
+                rows->pushBack(row);
+            }
+        }
+        return true;
+    }
+
+    // Rows of one round, oldest first: a main bracket round, or that round of every group.
+    int collectRoundMatches(int round, bool groupStage, DynamicArray<int>& rows) {
+        update();
+        return collectChain(groupStage ? groupStageRounds : bracketRounds, round, nextSameRound, rows);
+    }
+
+    int collectGroupMatches(int group, DynamicArray<int>& rows) {
+        update();
+        return collectChain(groups, group, nextSameGroup, rows);
+    }
+
+    // Net number of results won by the lower-ranked (higher rank number) player.
+    // Matches with an unranked player do not count.
+    long long countUpsets() {
+        update();
+        long long upsets = 0;
+        for (int c = 0; c < log.getNumChunks(); ++c) {
+            const unsigned char* types = log.getChunk(c).recordType;
+            const int* winnerRank = winnerRanks.data() + c * ColumnarMatchLog::CHUNK_ROWS;
+            const int* loserRank = loserRanks.data() + c * ColumnarMatchLog::CHUNK_ROWS;
+            int numRows = log.getRowsInChunk(c);
+            int chunkUpsets = 0;
+            for (int r = 0; r < numRows; ++r) { // No branches, so the compiler can vectorize it
+                int ranked = (winnerRank[r] > 0) & (loserRank[r] > 0);
+                int winnerWorse = ranked & (winnerRank[r] > loserRank[r]);
+                int loserWorse = ranked & (loserRank[r] > winnerRank[r]);
+                int type = types[r];
+                chunkUpsets += (type == RESULT) * winnerWorse + (type == OVERTURNED) * (winnerWorse - loserWorse)
+                             - (type == VOIDED) * winnerWorse;
+            }
+            upsets += chunkUpsets;
+        }
+        return upsets;
+    }
+
+    // Appends up to `limit` rows whose logged winner is the lower-ranked player (voids excluded).
+    // Returns how many such rows exist in total.
+    long long collectUpsets(DynamicArray<int>& rows, int limit) {
+        update();
+        long long found = 0;
+        for (int row = 0; row < indexedRows; ++row) {
+            if (loserRanks[row] > 0 && winnerRanks[row] > loserRanks[row]
+                && log.getChunk(row >> ColumnarMatchLog::CHUNK_SHIFT).recordType[row & (ColumnarMatchLog::CHUNK_ROWS - 1)] != VOIDED) {
+                if (found < limit) {
+                    rows.pushBack(row);
+                }
+                found++;
+            }
+        }
+        return found;
+    }
+
+    // Net wins between rank tiers of `tierWidth` ranks each (tier 0 = ranks 1..tierWidth).
+    void tierWinRates(int tierWidth, TierTable& table) {
+        update();
+        table.numTiers = 0;
+        for (int a = 0; a < MAX_TIERS; ++a) {
+            for (int b = 0; b < MAX_TIERS; ++b) {
+                table.wins[a][b] = 0;
+            }
+        }
+        if (tierWidth < 1) {
+            return;
+        }
+        for (int c = 0; c < log.getNumChunks(); ++c) {
+            const unsigned char* types = log.getChunk(c).recordType;
+            const int* winnerRank = winnerRanks.data() + c * ColumnarMatchLog::CHUNK_ROWS;
+            const int* loserRank = loserRanks.data() + c * ColumnarMatchLog::CHUNK_ROWS;
+            int numRows = log.getRowsInChunk(c);
+            for (int r = 0; r < numRows; ++r) {
+                if (winnerRank[r] <= 0 || loserRank[r] <= 0) {
+                    continue;
+                }
+                int winnerTier = tierOf(winnerRank[r], tierWidth);
+                int loserTier = tierOf(loserRank[r], tierWidth);
+                switch (types[r]) {
+                    case RESULT: table.wins[winnerTier][loserTier]++; break;
+                    case OVERTURNED: table.wins[winnerTier][loserTier]++; table.wins[loserTier][winnerTier]--; break;
+                    case VOIDED: table.wins[winnerTier][loserTier]--; break;
+                }
+                int highest = (winnerTier > loserTier) ? winnerTier : loserTier;
+                if (highest + 1 > table.numTiers) {
+                    table.numTiers = highest + 1;
+                }
+            }
+        }
+    }
+
+    // --- Report displays ---
+    void displayHeadToHead(const string& firstId, const string& secondId) {
+        cout << "\n--- Head-to-Head: " << firstId << " vs " << secondId << " ---" << endl;
+        HeadToHead record;
+        DynamicArray<int> rows;
+        if (!headToHead(firstId, secondId, record, &rows)) {
+            cout << "No matches have been logged for " << (log.findPlayer(firstId) < 0 ? firstId : secondId) << "." << endl;
+        } else if (record.records == 0) {
+            cout << "These players have not met." << endl;
+        } else {
+            cout << log.getPlayerName(log.findPlayer(firstId)) << " " << record.winsFirst << " - " << record.winsSecond << " "
+                 << log.getPlayerName(log.findPlayer(secondId)) << " (" << record.records << " log entries)" << endl;
+            printRows(rows);
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+
+    void displayRoundMatches(int round, bool groupStage) {
+        DynamicArray<int> rows;
+        collectRoundMatches(round, groupStage, rows);
+        cout << "\n--- " << (groupStage ? "Group Stage" : "Main Bracket") << " Round " << round << " (" << rows.size() << " Matches) ---" << endl;
+        if (rows.isEmpty()) {
+            cout << "No matches were logged for this round." << endl;
+        }
+        printRows(rows);
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+
+    void displayGroupMatches(int group) {
+        DynamicArray<int> rows;
+        collectGroupMatches(group, rows);
+        cout << "\n--- Group " << group << " (" << rows.size() << " Matches) ---" << endl;
+        if (rows.isEmpty()) {
+            cout << "No matches were logged for this group." << endl;
+        }
+        printRows(rows);
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+
+    void displayUpsets(int limit = 20) {
+        DynamicArray<int> rows;
+        long long found = collectUpsets(rows, limit);
+        cout << "\n--- Upsets (Lower-Ranked Player Won): " << countUpsets() << " net of corrections ---" << endl;
+        if (found == 0) {
+            cout << "No upsets have been logged." << endl;
+        }
+        printRows(rows);
+        if (found > rows.size()) {
+            cout << "  ... and " << (found - rows.size()) << " more." << endl;
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+
+    void displayTierWinRates(int tierWidth) {
+        TierTable table;
+        tierWinRates(tierWidth, table);
+        cout << "\n--- Tier vs Tier Win Rates (" << tierWidth << " ranks per tier) ---" << endl;
+        if (table.numTiers == 0) {
+            cout << "No ranked matches have been logged." << endl;
+        }
+        for (int a = 0; a < table.numTiers; ++a) {
+            for (int b = 0; b < table.numTiers; ++b) {
+                long long games = table.wins[a][b] + table.wins[b][a];
+                if (a == b || games <= 0) {
+                    continue;
+                }
+                cout << "  " << tierLabel(a, tierWidth) << " vs " << tierLabel(b, tierWidth) << ": " << table.wins[a][b] << " wins / " << games << " matches ("
+                     << (100 * table.wins[a][b] / games) << "%)" << endl;
+            }
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+    }
+};
+
+
+// --- RoundRobinGenerator ---
+// Circle method for any group size: seat the players around a table (plus an empty
+// "bye" seat when the count is odd), keep seat 0 fixed and rotate everyone else one seat
+// per round. Pairings are computed from the round number on demand, so a group of n
+// players never stores its O(n^2) match list. Double round robin repeats the cycle
+// with home and away swapped.
+class RoundRobinGenerator {
+private:
+    int numPlayers;
+    int numSeats;          // numPlayers rounded up to an even number
+    bool doubleRoundRobin;
+
+    // Player sitting in `seat` during `cycleRound` (0 .. numSeats-2)
+    int playerAtSeat(int seat, int cycleRound) const {
+        if (seat == 0) {
+            return 0;
+        }
+        return ((seat - 1 + cycleRound) % (numSeats - 1)) + 1;
+    }
+
+public:
+    RoundRobinGenerator(int playersInGroup, bool playTwice = false) :
+        numPlayers(playersInGroup),
+        numSeats(playersInGroup + (playersInGroup % 2)),
+        doubleRoundRobin(playTwice) {}
+
+    int getNumRounds() const {
+        if (numPlayers < 2) {
+            return 0;
+        }
+        return (numSeats - 1) * (doubleRoundRobin ? 2 : 1);
+    }
+
+    // Number of pairing slots per round, including the bye slot for odd groups.
+    int getSlotsPerRound() const {
+        return numSeats / 2;
+    }
+
+    int getMatchesPerRound() const {
+        return numPlayers / 2;
+    }
+
+    // Gives the two group positions (0-based) meeting in `slot` of `round`.
+    // Returns false when the slot is the bye of an odd-sized group.
+    bool getPairing(int round, int slot, int& home, int& away) const {
+        int cycleRound = round % (numSeats - 1);
+        int seatA = playerAtSeat(slot, cycleRound);
+        int seatB = playerAtSeat(numSeats - 1 - slot, cycleRound);
+        if (seatA >= numPlayers || seatB >= numPlayers) {
+            return false;
+        }
+        // Alternate the fixed seat's side every round, and flip every pairing on the second cycle
+        bool swapSides = (slot == 0 && cycleRound % 2 == 1);
+        if (round >= numSeats - 1) {
+            swapSides = !swapSides;
+        }
+        home = swapSides ? seatB : seatA;
+        away = swapSides ? seatA : seatB;
+        return true;
+    }
+};
+
+// --- RoundBarrier ---
+// Reusable barrier for worker threads that advance in lockstep, one round at a time.
+class RoundBarrier {
+private:
+    mutex barrierMutex;
+    condition_variable allArrived;
+    int threshold;
+    int waiting;
+    int generation;
+
+public:
+    RoundBarrier(int numThreads) : threshold(numThreads), waiting(0), generation(0) {}
+
+    void arriveAndWait() {
+        unique_lock<mutex> lock(barrierMutex);
+        int arrivalGeneration = generation;
+        if (++waiting == threshold) {
+            waiting = 0;
+            generation++;
+            allArrived.notify_all();
+            return;
+        }
+        allArrived.wait(lock, [&] { return generation != arrivalGeneration; });
+    }
+};
+
+// --- GlickoSeasonRater ---
+// Batch ratings for a whole season of recorded matches, used to seed the next event. Matches
+// are taken in order and cut into rating periods of `matchesPerPeriod` matches. In each period
+// every player who played is rated against the ratings their opponents held when the period
+// began (Glicko-1), and a player's rating deviation grows with every period they sit out.
+// Periods are rated in parallel by player: players are dealt to the workers in blocks of
+// OWNER_BLOCK (so two workers rarely write the same cache line). Each worker scans the period's
+// matches, adds up the sums for its own players' games, and after a barrier writes their new
+// ratings. Each player's sums are added in match order by a single worker, so the ratings do
+// not depend on the number of threads.
+class GlickoSeasonRater {
+public:
+    static constexpr double INITIAL_RATING = 1500.0;  // Same scale as EloRating
+    static constexpr double INITIAL_DEVIATION = 350.0;
+    static constexpr double DEVIATION_GROWTH = 34.6;  // Per idle period: about 100 periods from 50 back to 350
+    static const int DEFAULT_PERIOD_MATCHES = 10000;
+
+    struct SeasonPlayer {
+        string playerId;    // As MatchHistoryRecord::storedId (differs from the full ID only past ID_CHARS)
+        string playerName;
+    };
+
+private:
+    struct SeasonGame {
+        int player1;    // Indices into players
+        int player2;
+        int winnerSide; // 1 or 2, 0 once voided (as in MatchHistoryRecord)
+    };
+
+    struct PlayerRating { // Read by every worker during a period, written between periods
+        double rating;
+        double deviation;
+        int lastPeriod;   // Last period the player was rated in, -1 for never
+        int gamesRated;
+    };
+
+    struct PeriodSums {   // Written only by the player's worker
+        double impact;    // Sum of g^2 * E * (1 - E)
+        double surprise;  // Sum of g * (score - E)
+        int period;       // Period the sums belong to
+        int games;
+    };
+
+    static const int OWNER_BLOCK = 16;
+    static const int PREFETCH_DISTANCE = 16; // Matches ahead whose players are fetched early
+
+    static constexpr double Q = 2.302585092994046 / 400.0; // ln(10) / 400
+    static constexpr double PI = 3.14159265358979323846;
+
+    int matchesPerPeriod;
+    DynamicArray<SeasonPlayer> players;
+    PlayerIdIndex playerIndex;
+    DynamicArray<SeasonGame> games;
+    long long numCorrections;
+
+    DynamicArray<PlayerRating> ratings; // Indexed like `players`
+    DynamicArray<PeriodSums> sums;
+
+    // Deviation of a player at the start of `period`.
+    static double deviationAt(const PlayerRating& player, int period) {
+        if (player.lastPeriod < 0) {
+            return INITIAL_DEVIATION;
+        }
+        double grown = sqrt(player.deviation * player.deviation
+                            + DEVIATION_GROWTH * DEVIATION_GROWTH * (period - player.lastPeriod));
+        return (grown < INITIAL_DEVIATION) ? grown : INITIAL_DEVIATION;
+    }
+
+    // Glicko's g(): how much an opponent's uncertain rating dampens a result.
+    static double attenuation(double deviation) {
+        return 1.0 / sqrt(1.0 + 3.0 * Q * Q * deviation * deviation / (PI * PI));
+    }
+
+    // Worker that owns a player: its block's Fibonacci hash scaled to the worker count (no division).
+    static int ownerOf(int player, int numWorkers) {
+        unsigned int blockHash = static_cast<unsigned int>(player / OWNER_BLOCK) * 2654435769u;
+        return static_cast<int>((static_cast<unsigned long long>(blockHash) * numWorkers) >> 32);
+    }
+
+    void addGame(int player, int opponent, bool won, int period, DynamicArray<int>& active) {
+        const PlayerRating& other = ratings[opponent];
+        double g = attenuation(deviationAt(other, period));
+        double expected = 1.0 / (1.0 + exp(-g * Q * (ratings[player].rating - other.rating)));
+        PeriodSums& sum = sums[player];
+        if (sum.period != period) {
+            sum.period = period;
+            sum.impact = sum.surprise = 0.0;
+            sum.games = 0;
+            active.pushBack(player);
+        }
+        sum.impact += g * g * expected * (1.0 - expected);
+        sum.surprise += g * ((won ? 1.0 : 0.0) - expected);
+        sum.games++;
+    }
+
+    void ratePlayer(int player, int period) {
+        PlayerRating& rated = ratings[player];
+        const PeriodSums& sum = sums[player];
+        double deviation = deviationAt(rated, period);
+        double precision = 1.0 / (deviation * deviation) + Q * Q * sum.impact; // 1/RD^2 + 1/d^2
+        rated.rating += Q / precision * sum.surprise;
+        rated.deviation = sqrt(1.0 / precision);
+        rated.lastPeriod = period;
+        rated.gamesRated += sum.games;
+    }
+
+    void ratePeriods(int worker, int numWorkers, RoundBarrier& barrier) {
+        DynamicArray<int> active;
+        for (int period = 0; period * static_cast<long long>(matchesPerPeriod) < games.size(); ++period) {
+            int first = period * matchesPerPeriod;
+            int last = (games.size() - first < matchesPerPeriod) ? games.size() : first + matchesPerPeriod;
+            for (int i = first; i < last; ++i) {
+                if (i + PREFETCH_DISTANCE < last) { // Player state is scattered over the whole season
+                    const SeasonGame& upcoming = games[i + PREFETCH_DISTANCE];
+                    bool owns1 = ownerOf(upcoming.player1, numWorkers) == worker;
+                    bool owns2 = ownerOf(upcoming.player2, numWorkers) == worker;
+                    if (owns1 || owns2) {
+                        PREFETCH(&ratings[upcoming.player1]);
+                        PREFETCH(&ratings[upcoming.player2]);
+                    }
+                    if (owns1) PREFETCH(&sums[upcoming.player1]);
+                    if (owns2) PREFETCH(&sums[upcoming.player2]);
+                }
+                const SeasonGame& game = games[i];
+                if (game.winnerSide == 0) {
+                    continue;
+                }
+                if (ownerOf(game.player1, numWorkers) == worker) {
+                    addGame(game.player1, game.player2, game.winnerSide == 1, period, active);
+                }
+                if (ownerOf(game.player2, numWorkers) == worker) {
+                    addGame(game.player2, game.player1, game.winnerSide == 2, period, active);
+                }
+            }
+            barrier.arriveAndWait(); // Every worker has read the ratings from the start of the period
+            for (int a = 0; a < active.size(); ++a) {
+                ratePlayer(active[a], period);
+            }
+            active.clear();
+            barrier.arriveAndWait(); // New ratings are in place before the next period reads them
+        }
+    }
+
+    // Season players are keyed by MatchHistoryRecord::storedId, the form history files keep.
+    int internPlayer(const MatchHistoryRecord& record, int side) {
+        string id = record.playerStoredId(side);
+        int player = playerIndex.find(PlayerIdCodec::encode(id));
+        if (player < 0) {
+            player = addStoredPlayer(id, record.playerName(side));
+        }
+        return player;
+    }
+
+    int addStoredPlayer(const string& storedId, const string& playerName) {
+        SeasonPlayer player = {storedId, playerName};
+        players.pushBack(player);
+        playerIndex.insert(PlayerIdCodec::encode(storedId), players.size() - 1);
+        return players.size() - 1;
+    }
+
+public:
+    explicit GlickoSeasonRater(int periodMatches = DEFAULT_PERIOD_MATCHES)
+        : matchesPerPeriod(periodMatches > 0 ? periodMatches : DEFAULT_PERIOD_MATCHES), numCorrections(0) {}
+
+    // Index of a new season player (the ID must not be known yet).
+    int addPlayer(const string& playerId, const string& playerName) {
+        return addStoredPlayer(MatchHistoryRecord::storedId(playerId), playerName);
+    }
+
+    // Appends a match between two season players; winnerSide is 1 or 2.
+    void addMatch(int player1, int player2, int winnerSide) {
+        SeasonGame game = {player1, player2, winnerSide};
+        games.pushBack(game);
+    }
+
+    // Appends every committed match of a history file. Corrections apply to the latest match
+    // with the same ID in the same file: an overturn changes its winner and a void removes it
+    // (a replay is logged as a new result). Returns false if the file cannot be read.
+    bool loadHistoryFile(const string& path) {
+        MatchHistoryFileReader history;
+        if (!history.open(path)) {
+            return false;
+        }
+        DynamicArray<int> gameOfMatch; // matchId -> index in games, -1 for none
+        for (long long i = 0; i < history.getNumRecords(); ++i) {
+            const MatchHistoryRecord& record = history.getRecord(i);
+            if (record.matchId < 0 || record.winnerSide == 0) {
+                continue;
+            }
+            while (gameOfMatch.size() <= record.matchId) {
+                gameOfMatch.pushBack(-1);
+            }
+            int player1 = internPlayer(record, 1);
+            int player2 = internPlayer(record, 2);
+            int winner = (record.winnerSide == 1) ? player1 : player2;
+            int game = gameOfMatch[record.matchId];
+            switch (static_cast<MatchRecordType>(record.recordType)) {
+                case MatchRecordType::Result:
+                    gameOfMatch[record.matchId] = games.size();
+                    addMatch(player1, player2, record.winnerSide);
+                    break;
+                case MatchRecordType::Overturned:
+                    if (game >= 0) {
+                        games[game].winnerSide = (winner == games[game].player1) ? 1 : 2;
+                        numCorrections++;
+                    }
+                    break;
+                case MatchRecordType::Voided:
+                    if (game >= 0) {
+                        games[game].winnerSide = 0;
+                        gameOfMatch[record.matchId] = -1;
+                        numCorrections++;
+                    }
+                    break;
+            }
+        }
+        return true;
+    }
+
+    // Rates the whole season from scratch on `numThreads` threads (the caller's thread included).
+    void recompute(int numThreads) {
+        ratings.clear();
+        sums.clear();
+        PlayerRating unrated = {INITIAL_RATING, INITIAL_DEVIATION, -1, 0};
+        PeriodSums noSums = {0.0, 0.0, -1, 0};
+        for (int p = 0; p < players.size(); ++p) {
+            ratings.pushBack(unrated);
+            sums.pushBack(noSums);
+        }
+
+        int blocks = (players.size() + OWNER_BLOCK - 1) / OWNER_BLOCK;
+        int numWorkers = (numThreads < blocks) ? numThreads : blocks;
+        if (numWorkers < 1) {
+            numWorkers = 1;
+        }
+        RoundBarrier barrier(numWorkers);
+        thread* workers = new thread[numWorkers - 1];
+        for (int w = 1; w < numWorkers; ++w) {
+            workers[w - 1] = thread(&GlickoSeasonRater::ratePeriods, this, w, numWorkers, ref(barrier));
+        }
+        ratePeriods(0, numWorkers, barrier);
+        for (int w = 1; w < numWorkers; ++w) {
+            workers[w - 1].join();
+        }
+        delete[] workers;
+    }
+
+    int getNumPlayers() const { return players.size(); }
+    int getNumMatches() const { return games.size(); }
+    long long getNumCorrections() const { return numCorrections; }
+    int getNumPeriods() const { return (games.size() + matchesPerPeriod - 1) / matchesPerPeriod; }
+    const SeasonPlayer& getPlayer(int player) const { return players[player]; }
+
+    // Index of a season player, or -1.
+    int findPlayer(const string& playerId) const {
+        return playerIndex.find(MatchHistoryRecord::storedId(playerId));
+    }
+
+    // Results of the last recompute(). The deviation is as of the player's last rated period.
+    double getRating(int player) const { return ratings[player].rating; }
+    double getDeviation(int player) const { return ratings[player].deviation; }
+    int getGamesRated(int player) const { return ratings[player].gamesRated; }
+
+    // Starts every tracked player who played this season from their season rating.
+    // Returns how many players were found.
+    int applyTo(GameResultLogger& logger) const {
+        int applied = 0;
+        for (int i = 0; i < logger.getNumTrackedPlayers(); ++i) {
+            const string& playerId = logger.getTrackedPlayerStats(i).playerId;
+            int player = findPlayer(playerId);
+            if (player >= 0 && player < ratings.size() && ratings[player].gamesRated > 0) {
+                logger.setStartingRating(playerId, ratings[player].rating);
+                applied++;
+            }
+        }
+        return applied;
+    }
+};
+
+// --- MatchScheduler Class (from original tournament system) ---
+class MatchScheduler {
+private:
+    DynamicArray<Player> initialPlayers;          // Array to store all initially added players
+    int numInitialPlayers;                        // Count of players in initialPlayers
+    PlayerIdIndex initialPlayerIndex;             // Player key -> position in initialPlayers
+    DynamicArray<Player> roundPlayersBuffer;      // Reused by createNextRoundPairings
+    int nextBracketRound;                         // Main bracket round the next pairings belong to
+    bool seedByRating;                            // Re-seed the field by rating in initializeTournament
+
+    RingBufferQueue<Player> waitingPlayersQueue; 
+    RingBufferQueue<Match> scheduledMatchesQueue; 
+    RingBufferQueue<Player> winnersQueue;         
+    
+    GameResultLogger& resultLogger; 
+    MatchOutcomeModel& outcomeModel; // Shared with the other scheduler modes
+    MatchIdSequence& matchIds;       // Per-tournament match numbering
+    SimulationLog& simLog;           // Buffered progress output
+
+    // Helper to sort players by rank (lower rank is better)
+    void sortPlayersByRank(Player arr[], int n) {
+        mergeSortPlayers(arr, n); 
+    }
+
+    // Helper struct for re-seeding by rating: where the player is now, and what they sort by
+    struct RatedSeed {
+        int position;   // Index into initialPlayers
+        int ranking;
+        double rating;
+    };
+
+    // Rating desc, then the better original seed (rank asc)
+    static bool seedsBefore(const RatedSeed& a, const RatedSeed& b) {
+        return a.rating > b.rating || (a.rating == b.rating && a.ranking < b.ranking);
+    }
+
+    // Stable bottom-up merge sort of the seeds (O(n log n), as mergeSortPlayers).
+    static void mergeSortSeeds(RatedSeed seeds[], int n) {
+        if (n < 2) {
+            return;
+        }
+        RatedSeed* scratch = new RatedSeed[n];
+        for (int width = 1; width < n; width *= 2) {
+            for (int left = 0; left + width < n; left += 2 * width) {
+                int mid = left + width;
+                int right = (left + 2 * width < n) ? left + 2 * width : n;
+                if (!seedsBefore(seeds[mid], seeds[mid - 1])) {
+                    continue; // Halves already in order
+                }
+                for (int k = left; k < mid; ++k) {
+                    scratch[k] = seeds[k];
+                }
+                int i = left, j = mid, k = left;
+                while (i < mid && j < right) {
+                    seeds[k++] = seedsBefore(seeds[j], scratch[i]) ? seeds[j++] : scratch[i++];
+                }
+                while (i < mid) {
+                    seeds[k++] = scratch[i++];
+                }
+            }
+        }
+        delete[] scratch;
+    }
+
+    // Re-ranks the field by rating (highest first, the better original seed breaking ties)
+    // and hands the new seeds to the logger. Only the small seeds are sorted; each Player
+    // is then moved once into its new place.
+    void reseedByRating() {
+        DynamicArray<RatedSeed> seeds(numInitialPlayers);
+        for (int i = 0; i < numInitialPlayers; ++i) {
+            RatedSeed seed = {i, initialPlayers[i].ranking, resultLogger.getRating(initialPlayers[i].playerId)};
+            seeds.pushBack(seed);
+        }
+        mergeSortSeeds(seeds.data(), numInitialPlayers);
+        DynamicArray<Player> reseeded(numInitialPlayers);
+        for (int i = 0; i < numInitialPlayers; ++i) {
+            reseeded.pushBack(std::move(initialPlayers[seeds[i].position]));
+            reseeded[i].ranking = i + 1;
+            resultLogger.setSeedRank(reseeded[i].playerId, i + 1);
+        }
+        initialPlayers.swap(reseeded);
+    }
+
+    // Helper struct for group stage results, for sorting
+    struct GroupPlayerResult {
+        Player player;
+        int groupWins;
+    };
+
+    // Work item passed between the stages of runPipelinedRound (indices into roundPlayersBuffer)
+    struct PipelinedMatch {
+        int matchId;
+        int player1;
+        int player2;
+        int winner;
+    };
+    static const int PIPELINE_QUEUE_CAPACITY = 1024;
+    static const int PIPELINE_LOG_BATCH = 256;
+
+    // Custom Insertion Sort for GroupPlayerResult (sort by wins desc, then rank asc)
+    void insertionSortGroupResults(GroupPlayerResult arr[], int n) {
+        for (int i = 1; i < n; ++i) {
+            GroupPlayerResult key = std::move(arr[i]);
+            int j = i - 1;
+
+            while (j >= 0 && (arr[j].groupWins < key.groupWins || (arr[j].groupWins == key.groupWins && arr[j].player.ranking > key.player.ranking))) {
+                arr[j + 1] = std::move(arr[j]);
+                j = j - 1;
+            }
+            arr[j + 1] = std::move(key);
+        }
+    }
+
+public:
+    MatchScheduler(GameResultLogger& logger, MatchOutcomeModel& model, MatchIdSequence& ids, SimulationLog& log) :
+        initialPlayers(MAX_PLAYERS_UNIVERSAL), numInitialPlayers(0), initialPlayerIndex(MAX_PLAYERS_UNIVERSAL), roundPlayersBuffer(MAX_PLAYERS_UNIVERSAL), nextBracketRound(1), seedByRating(false),
+        resultLogger(logger), outcomeModel(model), matchIds(ids), simLog(log) {}
+
+    MatchIdSequence& getMatchIds() { return matchIds; }
+    const MatchIdSequence& getMatchIds() const { return matchIds; }
+
+    // Round number stamped on the next main bracket matches (restored from checkpoints).
+    int getNextBracketRound() const { return nextBracketRound; }
+    void setNextBracketRound(int round) { nextBracketRound = round; }
+
+    // Adds a player to the tournament and initializes them for stats tracking.
+    void addPlayer(const Player& player) {
+        addPlayer(Player(player));
+    }
+    // Same, taking over the player's strings (e.g. straight from a registration queue).
+    void addPlayer(Player&& player) {
+        // Prevent adding player with duplicate ID (if IDs are read from CSV)
+        int existing = initialPlayerIndex.find(player.idKey);
+        if (existing >= 0) {
+            cerr << "Error: Player with ID " << player.playerId << " (" << initialPlayers[existing].playerName 
+                 << ") already exists. Cannot add " << player.playerName << " with the same ID." << endl;
+            return; // Skip adding this player
+        }
+        resultLogger.initializePlayerForStats(player); 
+        initialPlayerIndex.insert(player.idKey, numInitialPlayers);
+        initialPlayers.pushBack(std::move(player));
+        numInitialPlayers++;
+    }
+    
+    int getNumInitialPlayers() const { 
+        return numInitialPlayers;
+    }
+
+    // With this on, initializeTournament seeds the field by the players' ratings in the logger
+    // (set from a season with GlickoSeasonRater::applyTo) instead of their registered ranks.
+    void setSeedByRating(bool enabled) { seedByRating = enabled; }
+
+    // Initializes the tournament by sorting all initial players.
+    void initializeTournament() {
+        if (numInitialPlayers == 0) {
+            simLog.at(LogVerbosity::Summary) << "No players added to the tournament to initialize.\n";
+            return;
+        }
+
+        if (seedByRating) {
+            reseedByRating();
+        }
+        // Sort all registered players by rank
+        sortPlayersByRank(initialPlayers.data(), numInitialPlayers); 
+        initialPlayerIndex.clear(); // Positions moved
+        for (int i = 0; i < numInitialPlayers; ++i) {
+            initialPlayerIndex.insert(initialPlayers[i].idKey, i);
+        }
+        simLog.at(LogVerbosity::Summary) << "\n--- All " << numInitialPlayers << " Players Sorted by "
+                                         << (seedByRating ? "Rating" : "Rank") << " (Initial Seeding) ---\n";
+        if (simLog.enabled(LogVerbosity::PerMatch)) { // The full seeding list is one line per player
+            for (int i = 0; i < numInitialPlayers; ++i) {
+                simLog.at(LogVerbosity::PerMatch) << (i + 1) << ". " << initialPlayers[i].playerName << " (Rank: " << initialPlayers[i].ranking << ", Type: " << initialPlayers[i].originalPriority << ")\n";
+            }
+            simLog.at(LogVerbosity::PerMatch) << "------------------------------------\n";
+        }
+    }
+
+    // Group Stage Method
+    void runGroupStage(int numGroups) {
+        if (numGroups <= 0) {
+            cerr << "Error: Number of groups must be positive for group stage." << endl;
+            return;
+        }
+        
+        // Expected players for full group stage: 6 * 4 + 10 * 4 = 24 + 40 = 64
+        if (numInitialPlayers < (6 * 4 + 10 * 4)) { 
+            cerr << "Warning: Not enough players (" << numInitialPlayers 
+                 << ") to form " << numGroups << " groups with required compositions. Skipping group stage or adjusting." << endl;
+            // If there's only one player after initialization, they are the champion.
+            if (numInitialPlayers == 1) {
+                winnersQueue.enqueue(initialPlayers[0]);
+                simLog.at(LogVerbosity::Summary) << initialPlayers[0].playerName << " is the sole player and advances directly as the champion after group stage.\n";
+            } else if (numInitialPlayers > 0) {
+                // If there are players but not enough for full groups,
+                // just advance all available players directly to the main bracket.
+                simLog.at(LogVerbosity::Summary) << "Not enough players for proper group stage. Advancing all " << numInitialPlayers << " players directly to main bracket.\n";
+                for (int i = 0; i < numInitialPlayers; ++i) {
+                    winnersQueue.enqueue(initialPlayers[i]);
+                }
+            }
+            return;
+        }
+        
+        simLog.at(LogVerbosity::Summary) << "\n--- Group Division: Starting Group Stage with " << numGroups << " Groups ---\n";
+
+        // Categorize players into temporary queues based on registration type
+        // Players are drawn from initialPlayers, which is already sorted by rank (strongest first)
+        RingBufferQueue<Player> earlyBirdsQ;
+        RingBufferQueue<Player> regularsQ;
+        RingBufferQueue<Player> wildcardsQ;
+
+        for (int i = 0; i < numInitialPlayers; ++i) {
+            if (initialPlayers[i].originalPriority == "early birds") { // Use exact string from CSV
+                earlyBirdsQ.enqueue(initialPlayers[i]);
+            } else if (initialPlayers[i].originalPriority == "regular") { // Use exact string from CSV
+                regularsQ.enqueue(initialPlayers[i]);
+            } else if (initialPlayers[i].originalPriority == "wildcard") { // Use exact string from CSV
+                wildcardsQ.enqueue(initialPlayers[i]);
+            } else {
+                cerr << "Warning: Unknown original priority for player: " << initialPlayers[i].playerName << " ('" << initialPlayers[i].originalPriority << "'). Skipping for group stage." << endl;
+            }
+        }
+
+        // Array of queues for groups (max 16 groups)
+        RingBufferQueue<Player> groupQueues[16]; 
+        int currentGroupIndex = 0;
+
+        // Form 6 groups of (1 early bird, 2 regular, 1 wildcard)
+        for (int i = 0; i < 6; ++i) {
+            if (earlyBirdsQ.isEmpty() || regularsQ.size() < 2 || wildcardsQ.isEmpty()) {
+                cerr << "Error: Not enough players for specific group composition (1 Early Bird, 2 Regular, 1 Wildcard) for group " << (i + 1) << ". Cannot complete group stage." << endl;
+                // Enqueue remaining players to winnersQueue if group stage cannot complete
+                while(!earlyBirdsQ.isEmpty()) winnersQueue.enqueue(earlyBirdsQ.dequeue());
+                while(!regularsQ.isEmpty()) winnersQueue.enqueue(regularsQ.dequeue());
+                while(!wildcardsQ.isEmpty()) winnersQueue.enqueue(wildcardsQ.dequeue());
+                return; 
+            }
+            groupQueues[currentGroupIndex].enqueue(earlyBirdsQ.dequeue());
+            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
+            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
+            groupQueues[currentGroupIndex].enqueue(wildcardsQ.dequeue());
+            simLog.at(LogVerbosity::PerRound) << "  Group " << (currentGroupIndex + 1) << " formed (1 Early Bird, 2 Regular, 1 Wildcard).\n";
+            currentGroupIndex++;
+        }
+
+        // Form 10 groups of (1 early bird, 3 regular)
+        for (int i = 0; i < 10; ++i) {
+            if (earlyBirdsQ.isEmpty() || regularsQ.size() < 3) {
+                cerr << "Error: Not enough players for specific group composition (1 Early Bird, 3 Regular) for group " << (i + 1) << ". Cannot complete group stage." << endl;
+                // Enqueue remaining players to winnersQueue if group stage cannot complete
+                while(!earlyBirdsQ.isEmpty()) winnersQueue.enqueue(earlyBirdsQ.dequeue());
+                while(!regularsQ.isEmpty()) winnersQueue.enqueue(regularsQ.dequeue());
+                while(!wildcardsQ.isEmpty()) winnersQueue.enqueue(wildcardsQ.dequeue());
+                return;
+            }
+            groupQueues[currentGroupIndex].enqueue(earlyBirdsQ.dequeue());
+            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
+            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
+            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
+            simLog.at(LogVerbosity::PerRound) << "  Group " << (currentGroupIndex + 1) << " formed (1 Early Bird, 3 Regular).\n";
+            currentGroupIndex++;
+        }
+
+        // Process each group: play matches and determine top 2
+        int playersAdvancedFromGroupStage = 0;
+        for (int i = 0; i < currentGroupIndex; ++i) { // Iterate through the 16 formed groups
+            TRACE_SPAN_INDEX("runGroupStage group", i + 1);
+            simLog.at(LogVerbosity::PerRound) << "\n--- Processing Group " << (i + 1) << " ---\n";
+            
+            if (groupQueues[i].size() != 4) { 
+                cerr << "Fatal Error: Group " << (i + 1) << " does not have exactly 4 players (" << groupQueues[i].size() << "). This should not happen if player counts are correct. Cannot run matches for this group." << endl;
+                groupQueues[i].clear();
+                continue; 
+            }
+
+            // Local group win tracking (the players stay in this order until the standings sort)
+            GroupPlayerResult groupResults[4];
+            for (int k = 0; k < 4; ++k) {
+                groupResults[k] = {groupQueues[i].dequeue(), 0};
+            }
+
+            // Single round robin: everyone plays the other 3 players once (3 rounds, 6 matches),
+            // so no pair gets an extra rematch
+            RoundRobinGenerator groupSchedule(4);
+            for (int round = 0; round < groupSchedule.getNumRounds(); ++round) {
+                METRICS_ROUND("group_stage", round + 1); // Totalled over the 16 groups
+                for (int slot = 0; slot < groupSchedule.getSlotsPerRound(); ++slot) {
+                    int home, away;
+                    if (!groupSchedule.getPairing(round, slot, home, away)) {
+                        continue;
+                    }
+                    Match currentMatch(groupResults[home].player, groupResults[away].player, matchIds.next());
+                    currentMatch.round = round + 1;
+                    currentMatch.group = i + 1;
+                
+                    outcomeModel.resolve(currentMatch);
+                    resultLogger.recordMatchOutcome(currentMatch); // Record for logging
+
+                    // Update group stage wins
+                    for(int k=0; k<4; ++k) {
+                        if(groupResults[k].player.idKey == currentMatch.winner.idKey) { 
+                            groupResults[k].groupWins++;
+                            break; 
+                        }
+                    }
+                    simLog.at(LogVerbosity::PerMatch) << "  Match: " << currentMatch.player1.playerName << " vs " << currentMatch.player2.playerName
+                         << " -> Winner: " << currentMatch.winner.playerName << "\n";
+                }
+            }
+
+            // Determine Top 2 from the group
+            insertionSortGroupResults(groupResults, 4); // Sort by group wins (desc), then rank (asc)
+
+            simLog.at(LogVerbosity::PerRound) << "  Group " << (i + 1) << " Standings (Top 2 advance):\n";
+            for(int k=0; k<4; ++k) {
+                simLog.at(LogVerbosity::PerRound) << "    " << (k+1) << ". " << groupResults[k].player.playerName << " (Group Wins: " << groupResults[k].groupWins << ")\n";
+            }
+
+            // Enqueue top 2 players to winnersQueue
+            simLog.at(LogVerbosity::PerRound) << "  " << groupResults[0].player.playerName << " and " << groupResults[1].player.playerName << " advance from Group " << (i+1) << ".\n";
+            winnersQueue.enqueue(std::move(groupResults[0].player));
+            playersAdvancedFromGroupStage++;
+            winnersQueue.enqueue(std::move(groupResults[1].player));
+            playersAdvancedFromGroupStage++;
+        }
+        simLog.at(LogVerbosity::Summary) << "\n--- Group Stage Complete. " << playersAdvancedFromGroupStage << " players advanced to main bracket. ---\n";
+    }
+
+
+    // League Group Stage: splits every player into round-robin groups of (about) `groupSize`,
+    // snake-seeded by rank, and advances the top `advancePerGroup` of each group.
+    // Rounds are simulated in parallel across groups by `numThreads` workers, while this thread
+    // logs the previous round's results in group order, so match IDs and the history log are
+    // the same for any thread count.
+    void runLeagueGroupStage(int groupSize, bool doubleRoundRobin, int advancePerGroup, int numThreads) {
+        if (groupSize < 2 || advancePerGroup < 1) {
+            cerr << "Error: League groups need at least 2 players and at least 1 advancing player." << endl;
+            return;
+        }
+        if (numInitialPlayers < 2) {
+            cerr << "Warning: Not enough players (" << numInitialPlayers << ") for a league group stage." << endl;
+            for (int i = 0; i < numInitialPlayers; ++i) {
+                winnersQueue.enqueue(initialPlayers[i]);
+            }
+            return;
+        }
+        if (numThreads < 1) {
+            numThreads = 1;
+        }
+
+        int numGroups = (numInitialPlayers + groupSize - 1) / groupSize;
+        if (numThreads > numGroups) {
+            numThreads = numGroups;
+        }
+        simLog.at(LogVerbosity::Summary) << "\n--- League Group Stage: " << numInitialPlayers << " players in " << numGroups << " groups ("
+             << (doubleRoundRobin ? "double" : "single") << " round robin, " << numThreads << " worker threads) ---\n";
+
+        // Snake seeding: rank order runs 1..G across the groups, then G..1 back, and so on
+        int* groupOfPlayer = new int[numInitialPlayers];
+        int* groupStart = new int[numGroups + 1];
+        for (int g = 0; g <= numGroups; ++g) {
+            groupStart[g] = 0;
+        }
+        for (int i = 0; i < numInitialPlayers; ++i) {
+            int pass = i / numGroups;
+            int position = i % numGroups;
+            groupOfPlayer[i] = (pass % 2 == 0) ? position : (numGroups - 1 - position);
+            groupStart[groupOfPlayer[i] + 1]++;
+        }
+        for (int g = 0; g < numGroups; ++g) {
+            groupStart[g + 1] += groupStart[g];
+        }
+        // groupMembers holds indices into initialPlayers, group by group, best seed first
+        int* groupMembers = new int[numInitialPlayers];
+        int* fillPosition = new int[numGroups];
+        for (int g = 0; g < numGroups; ++g) {
+            fillPosition[g] = groupStart[g];
+        }
+        for (int i = 0; i < numInitialPlayers; ++i) {
+            groupMembers[fillPosition[groupOfPlayer[i]]++] = i;
+        }
+
+        // Per-round result slots: one per pairing slot of each group
+        int* slotOffset = new int[numGroups + 1];
+        int maxRounds = 0;
+        slotOffset[0] = 0;
+        for (int g = 0; g < numGroups; ++g) {
+            RoundRobinGenerator schedule(groupStart[g + 1] - groupStart[g], doubleRoundRobin);
+            slotOffset[g + 1] = slotOffset[g] + schedule.getSlotsPerRound();
+            if (schedule.getNumRounds() > maxRounds) {
+                maxRounds = schedule.getNumRounds();
+            }
+        }
+        int slotsPerRound = slotOffset[numGroups];
+        int* roundResults[2];          // Winner's player index per slot, -1 for byes; double-buffered
+        int* roundOpponents[2][2];     // Home / away player index per slot
+        for (int b = 0; b < 2; ++b) {
+            roundResults[b] = new int[slotsPerRound];
+            roundOpponents[b][0] = new int[slotsPerRound];
+            roundOpponents[b][1] = new int[slotsPerRound];
+        }
+        int* groupWins = new int[numInitialPlayers]; // Indexed like initialPlayers; each group only touches its own players
+        for (int i = 0; i < numInitialPlayers; ++i) {
+            groupWins[i] = 0;
+        }
+
+        // Each group gets its own generator, seeded up front from the shared model
+        MatchOutcomeModel* groupModels = new MatchOutcomeModel[numGroups];
+        for (int g = 0; g < numGroups; ++g) {
+            groupModels[g].reseed(outcomeModel.nextSeed());
+        }
+
+        RoundBarrier roundBarrier(numThreads + 1);
+        thread* workers = new thread[numThreads];
+        for (int w = 0; w < numThreads; ++w) {
+            workers[w] = thread([&, w]() {
+                for (int round = 0; round < maxRounds; ++round) {
+                    int buffer = round % 2;
+                    for (int g = w; g < numGroups; g += numThreads) {
+                        int groupPlayers = groupStart[g + 1] - groupStart[g];
+                        RoundRobinGenerator schedule(groupPlayers, doubleRoundRobin);
+                        for (int slot = 0; slot < schedule.getSlotsPerRound(); ++slot) {
+                            int resultIndex = slotOffset[g] + slot;
+                            int home, away;
+                            if (round >= schedule.getNumRounds() || !schedule.getPairing(round, slot, home, away)) {
+                                roundResults[buffer][resultIndex] = -1;
+                                continue;
+                            }
+                            int homePlayer = groupMembers[groupStart[g] + home];
+                            int awayPlayer = groupMembers[groupStart[g] + away];
+                            int winnerPlayer = groupModels[g].player1Wins() ? homePlayer : awayPlayer;
+                            groupWins[winnerPlayer]++;
+                            roundOpponents[buffer][0][resultIndex] = homePlayer;
+                            roundOpponents[buffer][1][resultIndex] = awayPlayer;
+                            roundResults[buffer][resultIndex] = winnerPlayer;
+                        }
+                    }
+                    roundBarrier.arriveAndWait();
+                }
+            });
+        }
+
+        // Log round r while the workers simulate round r + 1 into the other buffer
+        Match loggedMatch(0);
+        int matchesLogged = 0;
+        for (int round = 0; round < maxRounds; ++round) {
+            METRICS_ROUND("league_group_stage", round + 1);
+            roundBarrier.arriveAndWait();
+            int buffer = round % 2;
+            loggedMatch.round = round + 1;
+            int group = 0;
+            for (int k = 0; k < slotsPerRound; ++k) {
+                while (k >= slotOffset[group + 1]) {
+                    group++;
+                }
+                int winnerPlayer = roundResults[buffer][k];
+                if (winnerPlayer < 0) {
+                    continue;
+                }
+                loggedMatch.group = group + 1;
+                loggedMatch.matchId = matchIds.next();
+                loggedMatch.player1 = initialPlayers[roundOpponents[buffer][0][k]];
+                loggedMatch.player2 = initialPlayers[roundOpponents[buffer][1][k]];
+                loggedMatch.winner = initialPlayers[winnerPlayer];
+                loggedMatch.played = true;
+                resultLogger.recordMatchOutcome(loggedMatch);
+                matchesLogged++;
+            }
+        }
+        for (int w = 0; w < numThreads; ++w) {
+            workers[w].join();
+        }
+
+        // Standings: sort each group's members by group wins (desc), then rank (asc)
+        int playersAdvanced = 0;
+        for (int g = 0; g < numGroups; ++g) {
+            int* members = groupMembers + groupStart[g];
+            int groupPlayers = groupStart[g + 1] - groupStart[g];
+            for (int i = 1; i < groupPlayers; ++i) {
+                int key = members[i];
+                int j = i - 1;
+                while (j >= 0 && (groupWins[members[j]] < groupWins[key] ||
+                       (groupWins[members[j]] == groupWins[key] && initialPlayers[members[j]].ranking > initialPlayers[key].ranking))) {
+                    members[j + 1] = members[j];
+                    j--;
+                }
+                members[j + 1] = key;
+            }
+
+            int numAdvancing = (advancePerGroup < groupPlayers) ? advancePerGroup : groupPlayers;
+            simLog.at(LogVerbosity::PerRound) << "  Group " << (g + 1) << " (" << groupPlayers << " players): ";
+            for (int k = 0; k < numAdvancing; ++k) {
+                winnersQueue.enqueue(initialPlayers[members[k]]);
+                playersAdvanced++;
+                simLog.at(LogVerbosity::PerRound) << (k > 0 ? ", " : "") << initialPlayers[members[k]].playerName << " (" << groupWins[members[k]] << " wins)";
+            }
+            simLog.at(LogVerbosity::PerRound) << " advance.\n";
+        }
+        simLog.at(LogVerbosity::Summary) << "\n--- League Group Stage Complete. " << matchesLogged << " matches played, "
+             << playersAdvanced << " players advanced to main bracket. ---\n";
+
+        delete[] workers;
+        delete[] groupModels;
+        delete[] groupWins;
+        for (int b = 0; b < 2; ++b) {
+            delete[] roundResults[b];
+            delete[] roundOpponents[b][0];
+            delete[] roundOpponents[b][1];
+        }
+        delete[] slotOffset;
+        delete[] fillPosition;
+        delete[] groupMembers;
+        delete[] groupStart;
+        delete[] groupOfPlayer;
+    }
+
+    // Creates match pairings for the next round from players in waitingPlayersQueue.
+    bool createNextRoundPairings() {
+        if (waitingPlayersQueue.size() < 2) {
+            return false; 
+        }
+
+        simLog.at(LogVerbosity::PerRound) << "\n--- Creating Pairings for Next Round ---\n";
+
+        // Extract players from waiting queue to a temporary array for pairing logic
+        roundPlayersBuffer.clear();
+        while(!waitingPlayersQueue.isEmpty()) {
+            roundPlayersBuffer.pushBack(waitingPlayersQueue.dequeue());
+        }
+        Player* roundPlayersArray = roundPlayersBuffer.data();
+        int numRoundPlayers = roundPlayersBuffer.size();
+        
+        // Ensure players are sorted by rank before pairing for next round
+        sortPlayersByRank(roundPlayersArray, numRoundPlayers);
+
+        int i = 0, j = numRoundPlayers - 1;
+        while (i < j) {
+            Match& newMatch = scheduledMatchesQueue.emplace(std::move(roundPlayersArray[i]), std::move(roundPlayersArray[j]), matchIds.next());
+            newMatch.round = nextBracketRound;
+            simLog.at(LogVerbosity::PerMatch) << "Scheduled: " << newMatch.player1.playerName << " (Rank: " << newMatch.player1.ranking << ") vs " << newMatch.player2.playerName << " (Rank: " << newMatch.player2.ranking << ")\n";
+            i++;
+            j--;
+        }
+
+        if (i == j) { // One player remains in the middle - receives a bye
+            simLog.at(LogVerbosity::PerMatch) << roundPlayersArray[i].playerName << " gets a BYE and advances directly to the winners' pool.\n";
+            winnersQueue.enqueue(std::move(roundPlayersArray[i])); 
+        }
+        simLog.at(LogVerbosity::PerRound) << "------------------------------------\n";
+        nextBracketRound++;
+        return !scheduledMatchesQueue.isEmpty() || (numRoundPlayers > 0 && i == j);
+    }
+
+    // Simulates playing scheduled matches and processes their outcomes.
+    void playAndProcessMatches() {
+        if (scheduledMatchesQueue.isEmpty()) {
+            return; 
+        }
+        
+        simLog.at(LogVerbosity::PerRound) << "\n--- Playing and Processing Matches ---\n";
+        while (!scheduledMatchesQueue.isEmpty()) {
+            Match currentMatch = scheduledMatchesQueue.dequeue();
+            outcomeModel.resolve(currentMatch);
+
+            simLog.at(LogVerbosity::PerMatch) << currentMatch.player1.playerName << " vs " << currentMatch.player2.playerName
+                 << " -> Winner: " << currentMatch.winner.playerName << "\n";
+            
+            resultLogger.recordMatchOutcome(currentMatch); 
+
+            winnersQueue.enqueue(std::move(currentMatch.winner)); 
+        }
+        simLog.at(LogVerbosity::PerRound) << "------------------------------------\n";
+    }
+
+    // Pipelined round: a producer thread emits the pairings, `numWorkers` threads resolve
+    // matches, and this thread is the single logger consumer. Stages are linked by bounded
+    // lock-free queues. Outcomes depend only on the round seed and match ID, and the consumer
+    // restores match-ID order before logging, so history matches a single-threaded run.
+    // Replaces createNextRoundPairings() + playAndProcessMatches() for one round.
+    bool runPipelinedRound(int numWorkers) {
+        if (waitingPlayersQueue.size() < 2) {
+            return false;
+        }
+        if (numWorkers < 1) {
+            numWorkers = 1;
+        }
+
+        roundPlayersBuffer.clear();
+        while (!waitingPlayersQueue.isEmpty()) {
+            roundPlayersBuffer.pushBack(waitingPlayersQueue.dequeue());
+        }
+        sortPlayersByRank(roundPlayersBuffer.data(), roundPlayersBuffer.size());
+        const Player* roundPlayersArray = roundPlayersBuffer.data();
+        int numRoundPlayers = roundPlayersBuffer.size();
+        int numMatches = numRoundPlayers / 2;
+
+        simLog.at(LogVerbosity::PerRound) << "\n--- Pipelined Round: " << numMatches << " matches on " << numWorkers << " worker threads ---\n";
+        if (numRoundPlayers % 2 == 1) { // Middle player receives a bye, same as createNextRoundPairings
+            simLog.at(LogVerbosity::PerMatch) << roundPlayersArray[numMatches].playerName << " gets a BYE and advances directly to the winners' pool.\n";
+            winnersQueue.enqueue(roundPlayersArray[numMatches]);
+        }
+
+        // IDs and the outcome stream are fixed before any thread starts
+        int firstMatchId = matchIds.reserve(numMatches);
+        unsigned long long roundSeed = outcomeModel.nextSeed();
+
+        BoundedMpmcQueue<PipelinedMatch> pairingQueue(PIPELINE_QUEUE_CAPACITY);
+        BoundedMpmcQueue<PipelinedMatch> resultQueue(PIPELINE_QUEUE_CAPACITY);
+
+        thread pairingProducer([&]() {
+            for (int k = 0; k < numMatches; ++k) {
+                PipelinedMatch pairing = {firstMatchId + k, k, numRoundPlayers - 1 - k, -1};
+                pairingQueue.enqueue(pairing);
+            }
+            PipelinedMatch stopSignal = {-1, -1, -1, -1};
+            for (int w = 0; w < numWorkers; ++w) {
+                pairingQueue.enqueue(stopSignal);
+            }
+        });
+
+        thread* matchWorkers = new thread[numWorkers];
+        for (int w = 0; w < numWorkers; ++w) {
+            matchWorkers[w] = thread([&]() {
+                while (true) {
+                    PipelinedMatch pairing = pairingQueue.dequeue();
+                    if (pairing.matchId < 0) {
+                        break;
+                    }
+                    bool player1Won = MatchOutcomeModel::player1WinsMatch(roundSeed, pairing.matchId);
+                    pairing.winner = player1Won ? pairing.player1 : pairing.player2;
+                    resultQueue.enqueue(pairing);
+                }
+            });
+        }
+
+        // Logger consumer: park out-of-order results, then record the next in-order run as one batch
+        int* winnerOfMatch = new int[numMatches > 0 ? numMatches : 1];
+        for (int k = 0; k < numMatches; ++k) {
+            winnerOfMatch[k] = -1;
+        }
+        Match loggedMatch(0);
+        loggedMatch.round = nextBracketRound++;
+        int nextToLog = 0;
+        while (nextToLog < numMatches) {
+            PipelinedMatch result;
+            int drained = 0;
+            while (drained < PIPELINE_LOG_BATCH && resultQueue.tryDequeue(result)) {
+                winnerOfMatch[result.matchId - firstMatchId] = result.winner;
+                drained++;
+            }
+            if (drained == 0) {
+                this_thread::yield();
+                continue;
+            }
+            while (nextToLog < numMatches && winnerOfMatch[nextToLog] >= 0) {
+                loggedMatch.matchId = firstMatchId + nextToLog;
+                loggedMatch.player1 = roundPlayersArray[nextToLog];
+                loggedMatch.player2 = roundPlayersArray[numRoundPlayers - 1 - nextToLog];
+                loggedMatch.winner = roundPlayersArray[winnerOfMatch[nextToLog]];
+                loggedMatch.played = true;
+                simLog.at(LogVerbosity::PerMatch) << loggedMatch.player1.playerName << " vs " << loggedMatch.player2.playerName
+                     << " -> Winner: " << loggedMatch.winner.playerName << "\n";
+                resultLogger.recordMatchOutcome(loggedMatch);
+                winnersQueue.enqueue(loggedMatch.winner);
+                nextToLog++;
+            }
+        }
+
+        pairingProducer.join();
+        for (int w = 0; w < numWorkers; ++w) {
+            matchWorkers[w].join();
+        }
+        delete[] matchWorkers;
+        delete[] winnerOfMatch;
+        simLog.at(LogVerbosity::PerRound) << "------------------------------------\n";
+        return true;
+    }
+
+    // Advances winners from the winnersQueue to the waitingPlayersQueue for the next round.
+    bool advanceToNextRound() {
+        if (winnersQueue.isEmpty() && waitingPlayersQueue.isEmpty()) {
+            return false;
+        }
+
+        if (winnersQueue.size() == 1 && waitingPlayersQueue.isEmpty() && scheduledMatchesQueue.isEmpty()) {
+            waitingPlayersQueue.enqueue(winnersQueue.dequeue()); 
+            simLog.at(LogVerbosity::PerRound) << "\n--- Advancing Final Player ---\n";
+            simLog.at(LogVerbosity::PerRound) << waitingPlayersQueue.front().playerName << " is the sole remaining player.\n";
+            simLog.at(LogVerbosity::PerRound) << "------------------------------------\n";
+            return false; 
+        }
+        
+        simLog.at(LogVerbosity::PerRound) << "\n--- Advancing Winners to Next Round's Waiting Pool ---\n";
+        while (!winnersQueue.isEmpty()) {
+            simLog.at(LogVerbosity::PerMatch) << winnersQueue.front().playerName << " advances.\n";
+            waitingPlayersQueue.enqueue(winnersQueue.dequeue());
+        }
+        simLog.at(LogVerbosity::PerRound) << "------------------------------------\n";
+
+        return waitingPlayersQueue.size() >= 1; 
+    }
+
+    // Display functions for queues (mostly for debugging)
+    void displayScheduledMatches() const { 
+        cout << "\n--- Current Scheduled Matches (" << scheduledMatchesQueue.size() << ") ---" << endl;
+        if (scheduledMatchesQueue.isEmpty()) {
+            cout << "No matches currently scheduled." << endl;
+        } else {
+            for (const Match& match : scheduledMatchesQueue) {
+                cout << match << endl;
+            }
+        }
+        cout << "------------------------------------" << endl;
+    }
+    void displayWaitingPlayers() const { 
+        cout << "\n--- Players Waiting for Next Round (" << waitingPlayersQueue.size() << ") ---" << endl;
+        if (waitingPlayersQueue.isEmpty()) {
+            cout << "No players currently waiting." << endl;
+        } else {
+            for (const Player& player : waitingPlayersQueue) {
+                cout << player << endl;
+            }
+        }
+        cout << "------------------------------------" << endl;    
+    }
+    void displayWinners() const { 
+        cout << "\n--- Winners from Last Played Round (Before Advancing) (" << winnersQueue.size() << ") ---" << endl;
+        if (winnersQueue.isEmpty()) {
+            cout << "No winners recorded from the last round / No matches played yet / Winners already advanced." << endl;
+        } else {
+            for (const Player& player : winnersQueue) {
+                cout << player << endl;
+            }
+        }
+        cout << "------------------------------------" << endl;
+    }
+
+    // Hands the players waiting for the next round to another bracket mode (e.g. double elimination).
+    bool hasWaitingPlayers() const {
+        return !waitingPlayersQueue.isEmpty();
+    }
+    Player dequeueWaitingPlayer() {
+        return waitingPlayersQueue.dequeue();
+    }
+
+    // Checks if the tournament has concluded
+    bool isTournamentOver() const {
+        return (waitingPlayersQueue.size() == 1 && scheduledMatchesQueue.isEmpty() && winnersQueue.isEmpty());
+    }
+
+    // Returns the tournament champion if the tournament is over.
+    const Player& getTournamentWinner() const {
+        if (isTournamentOver()) {
+            return waitingPlayersQueue.front(); 
+        }
+        if (winnersQueue.size() == 1 && waitingPlayersQueue.isEmpty() && scheduledMatchesQueue.isEmpty()) {
+            return winnersQueue.front();
+        }
+        return Player::none(); // Empty player (ID "") if no winner yet or error state
+    }
+    Player getInitialPlayer(int index) const { // For one-player fallback
+        if (index >= 0 && index < numInitialPlayers) {
+            return initialPlayers[index];
+        }
+        return Player(); 
+    }
+
+    // Checkpoint support: saves the three bracket queues in order
+    void writeBracketState(CheckpointWriter& out) const {
+        out.writeUInt32(static_cast<unsigned int>(waitingPlayersQueue.size()));
+        for (const Player& player : waitingPlayersQueue) {
+            out.writePlayer(player);
+        }
+        out.writeUInt32(static_cast<unsigned int>(scheduledMatchesQueue.size()));
+        for (const Match& match : scheduledMatchesQueue) {
+            out.writeMatch(match);
+        }
+        out.writeUInt32(static_cast<unsigned int>(winnersQueue.size()));
+        for (const Player& player : winnersQueue) {
+            out.writePlayer(player);
+        }
+    }
+
+    // Replaces the bracket queues with the ones saved by writeBracketState()
+    void readBracketState(CheckpointReader& in) {
+        waitingPlayersQueue.clear();
+        scheduledMatchesQueue.clear();
+        winnersQueue.clear();
+
+        unsigned int count = in.readUInt32();
+        for (unsigned int i = 0; i < count; ++i) {
+            waitingPlayersQueue.enqueue(in.readPlayer());
+        }
+        count = in.readUInt32();
+        for (unsigned int i = 0; i < count; ++i) {
+            scheduledMatchesQueue.enqueue(in.readMatch());
+        }
+        count = in.readUInt32();
+        for (unsigned int i = 0; i < count; ++i) {
+            winnersQueue.enqueue(in.readPlayer());
+        }
+    }
+};
+
+// --- DoubleEliminationScheduler ---
+// Main bracket mode where a player is only knocked out after their second loss.
+// Winners-bracket losers drop into the losers bracket, and the grand final needs a
+// reset match when the losers-bracket champion beats the unbeaten winners-bracket champion.
+// Both brackets are flat arrays of indices into `players`, played level by level; all of
+// them are sized once in initializeBracket() so playing matches allocates nothing.
+class DoubleEliminationScheduler {
+private:
+    DynamicArray<Player> players;   // Every entrant, sorted by rank when the bracket is initialized
+
+    int* winnersBracket;            // Players still unbeaten
+    int numWinnersBracket;
+    int* losersBracket;             // Players with exactly one loss
+    int numLosersBracket;
+    int* droppedPlayers;            // Players who lost in the latest winners-bracket round
+    int numDroppedPlayers;
+    int* nextRoundBuffer;           // Scratch array the next level is written into
+    int bracketCapacity;
+
+    Match currentMatch;             // Reused for every game so the strings keep their capacity
+    int levelNumber;
+    int matchesPlayed;
+    int championIndex;
+    bool bracketInitialized;
+
+    GameResultLogger& resultLogger;
+    MatchOutcomeModel& outcomeModel;
+    MatchIdSequence& matchIds;
+    SimulationLog& simLog;
+
+    void releaseBracketArrays() {
+        delete[] winnersBracket;
+        delete[] losersBracket;
+        delete[] droppedPlayers;
+        delete[] nextRoundBuffer;
+        winnersBracket = losersBracket = droppedPlayers = nextRoundBuffer = nullptr;
+        bracketCapacity = 0;
+    }
+
+    // Plays one match between two entrants, records it and returns the winner's index.
+    int playMatch(int playerIndex1, int playerIndex2, const char* stageName) {
+        currentMatch.matchId = matchIds.next();
+        currentMatch.round = levelNumber;
+        currentMatch.player1 = players[playerIndex1];
+        currentMatch.player2 = players[playerIndex2];
+        outcomeModel.resolve(currentMatch);
+        resultLogger.recordMatchOutcome(currentMatch);
+        matchesPlayed++;
+
+        bool player1Won = (currentMatch.winner.idKey == currentMatch.player1.idKey);
+        simLog.at(LogVerbosity::PerMatch) << "  [" << stageName << "] " << currentMatch.player1.playerName << " vs " << currentMatch.player2.playerName
+             << " -> Winner: " << currentMatch.winner.playerName << "\n";
+        return player1Won ? playerIndex1 : playerIndex2;
+    }
+
+    // Pairs the strongest remaining seed with the weakest (same rule as the single-elimination bracket).
+    // Winners are written to `winnersOut` in pairing order; a middle player without an opponent gets a bye.
+    // Losers are appended to `losersOut` when it is not null. Returns the number of winners.
+    int playPairedRound(const int* entrants, int numEntrants, int* winnersOut,
+                        int* losersOut, int& numLosersOut, const char* stageName) {
+        int numAdvancing = 0;
+        int i = 0, j = numEntrants - 1;
+        while (i < j) {
+            int winnerIndex = playMatch(entrants[i], entrants[j], stageName);
+            winnersOut[numAdvancing++] = winnerIndex;
+            if (losersOut != nullptr) {
+                losersOut[numLosersOut++] = (winnerIndex == entrants[i]) ? entrants[j] : entrants[i];
+            }
+            i++;
+            j--;
+        }
+        if (i == j) { // BYE
+            winnersOut[numAdvancing++] = entrants[i];
+        }
+        return numAdvancing;
+    }
+
+    // Losers-bracket "major" round: survivors face the players who just dropped from the winners bracket.
+    // Pairing is crossed (best survivor vs last dropped player) to avoid immediate rematches.
+    void playLosersMajorRound() {
+        int numAdvancing = 0;
+        int numPairs = (numLosersBracket < numDroppedPlayers) ? numLosersBracket : numDroppedPlayers;
+        for (int k = 0; k < numPairs; ++k) {
+            nextRoundBuffer[numAdvancing++] = playMatch(losersBracket[k], droppedPlayers[numDroppedPlayers - 1 - k], "Losers");
+        }
+        // Whoever has no opponent on the other side advances on a bye
+        for (int k = numPairs; k < numLosersBracket; ++k) {
+            nextRoundBuffer[numAdvancing++] = losersBracket[k];
+        }
+        for (int k = numPairs; k < numDroppedPlayers; ++k) {
+            nextRoundBuffer[numAdvancing++] = droppedPlayers[numDroppedPlayers - 1 - k];
+        }
+        std::swap(losersBracket, nextRoundBuffer);
+        numLosersBracket = numAdvancing;
+        numDroppedPlayers = 0;
+    }
+
+    // Losers-bracket "minor" round: survivors play each other; the loser of each match is eliminated.
+    void playLosersMinorRound() {
+        int ignoredLosers = 0;
+        numLosersBracket = playPairedRound(losersBracket, numLosersBracket, nextRoundBuffer, nullptr, ignoredLosers, "Losers");
+        std::swap(losersBracket, nextRoundBuffer);
+    }
+
+    void playGrandFinal() {
+        int winnersChampion = winnersBracket[0];
+        if (numLosersBracket == 0) { // Only one entrant: nobody to play
+            championIndex = winnersChampion;
+            return;
+        }
+        int losersChampion = losersBracket[0];
+        simLog.at(LogVerbosity::PerRound) << "\n--- Grand Final ---\n";
+        int finalWinner = playMatch(winnersChampion, losersChampion, "Grand Final");
+        if (finalWinner == losersChampion) {
+            // Both players now have one loss, so the final is replayed
+            simLog.at(LogVerbosity::PerRound) << "Bracket reset! " << players[losersChampion].playerName << " handed "
+                 << players[winnersChampion].playerName << " their first loss.\n";
+            finalWinner = playMatch(winnersChampion, losersChampion, "Grand Final Reset");
+        }
+        championIndex = finalWinner;
+    }
+
+public:
+    DoubleEliminationScheduler(GameResultLogger& logger, MatchOutcomeModel& model, MatchIdSequence& ids, SimulationLog& log) :
+        players(MAX_PLAYERS_UNIVERSAL),
+        winnersBracket(nullptr), numWinnersBracket(0),
+        losersBracket(nullptr), numLosersBracket(0),
+        droppedPlayers(nullptr), numDroppedPlayers(0),
+        nextRoundBuffer(nullptr), bracketCapacity(0),
+        currentMatch(0), levelNumber(0), matchesPlayed(0), championIndex(-1), bracketInitialized(false),
+        resultLogger(logger), outcomeModel(model), matchIds(ids), simLog(log) {}
+
+    ~DoubleEliminationScheduler() {
+        releaseBracketArrays();
+    }
+
+    // The bracket owns raw arrays, so it is not copyable
+    DoubleEliminationScheduler(const DoubleEliminationScheduler&) = delete;
+    DoubleEliminationScheduler& operator=(const DoubleEliminationScheduler&) = delete;
+
+    // Pre-sizes player storage for large events (optional).
+    void reservePlayers(int expectedPlayers) {
+        players.reserve(expectedPlayers);
+    }
+
+    // Adds an entrant. Stats tracking is initialized in the shared logger (no-op if already tracked).
+    void addPlayer(const Player& player) {
+        if (bracketInitialized) {
+            cerr << "Error: Cannot add " << player.playerName << " after the double-elimination bracket has started." << endl;
+            return;
+        }
+        players.pushBack(player);
+        resultLogger.initializePlayerForStats(player);
+    }
+
+    int getNumPlayers() const {
+        return players.size();
+    }
+
+    int getMatchesPlayed() const {
+        return matchesPlayed;
+    }
+
+    // Seeds every entrant into the winners bracket (best rank first) and sizes all bracket arrays.
+    void initializeBracket() {
+        int numPlayers = players.size();
+        mergeSortPlayers(players.data(), numPlayers);
+
+        releaseBracketArrays();
+        bracketCapacity = (numPlayers > 0) ? numPlayers : 1;
+        winnersBracket = new int[bracketCapacity];
+        losersBracket = new int[bracketCapacity];
+        droppedPlayers = new int[bracketCapacity];
+        nextRoundBuffer = new int[bracketCapacity];
+
+        for (int i = 0; i < numPlayers; ++i) {
+            winnersBracket[i] = i;
+        }
+        numWinnersBracket = numPlayers;
+        numLosersBracket = 0;
+        numDroppedPlayers = 0;
+        levelNumber = 0;
+        matchesPlayed = 0;
+        championIndex = (numPlayers == 1) ? 0 : -1;
+        bracketInitialized = true;
+
+        simLog.at(LogVerbosity::Summary) << "\n--- Double-Elimination Bracket Seeded with " << numPlayers << " Players ---\n";
+    }
+
+    bool isTournamentOver() const {
+        return championIndex >= 0 || (bracketInitialized && players.size() == 0);
+    }
+
+    // Plays one level: a winners-bracket round followed by the losers-bracket rounds it feeds.
+    // When both brackets are down to one player the grand final is played.
+    // Returns false once a champion has been decided.
+    bool playNextLevel() {
+        if (!bracketInitialized || isTournamentOver()) {
+            return false;
+        }
+        levelNumber++;
+        simLog.at(LogVerbosity::PerRound) << "\n<<<<< LEVEL " << levelNumber << " (Double Elimination) >>>>>\n";
+
+        if (numWinnersBracket > 1) {
+            numDroppedPlayers = 0;
+            numWinnersBracket = playPairedRound(winnersBracket, numWinnersBracket, nextRoundBuffer,
+                                                droppedPlayers, numDroppedPlayers, "Winners");
+            std::swap(winnersBracket, nextRoundBuffer);
+
+            if (numLosersBracket == 0) {
+                // First drop-down: these players start the losers bracket
+                for (int k = 0; k < numDroppedPlayers; ++k) {
+                    losersBracket[k] = droppedPlayers[k];
+                }
+                numLosersBracket = numDroppedPlayers;
+                numDroppedPlayers = 0;
+            } else {
+                playLosersMajorRound();
+            }
+        }
+
+        // Thin the losers bracket until it matches the number of players the next winners round will drop
+        int expectedDrops = (numWinnersBracket > 1) ? numWinnersBracket / 2 : 0;
+        while (numLosersBracket > 1 && numLosersBracket > expectedDrops) {
+            playLosersMinorRound();
+        }
+
+        if (numWinnersBracket <= 1 && numLosersBracket <= 1) {
+            playGrandFinal();
+        }
+        return !isTournamentOver();
+    }
+
+    // Plays levels until a champion is decided.
+    void runToCompletion() {
+        for (int level = 1; ; ++level) {
+            METRICS_ROUND("double_elimination", level);
+            TRACE_SPAN_INDEX("double elimination level", level);
+            if (!playNextLevel()) {
+                break;
+            }
+        }
+    }
+
+    const Player& getTournamentWinner() const {
+        if (championIndex >= 0) {
+            return players[championIndex];
+        }
+        return Player::none();
     }
 };
 
-
-// --- GameResultLogger Class
-class GameResultLogger {
+// --- EventDrivenBracket ---
+// Single-elimination bracket that advances on individual results instead of whole rounds.
+// The bracket is a complete binary tree kept in flat arrays: node 1 is the final, node k is
+// fed by nodes 2k and 2k+1, and nodes bracketSize..2*bracketSize-1 are the seeded entry slots.
+// A match is released the moment both of its feeder slots are decided, so results can be
+// reported in any order and the next match never waits for the rest of the round.
+class EventDrivenBracket {
 private:
-    CustomStack<HistoricalMatch> recentMatchesLog;         
-    CustomQueue<HistoricalMatch> allMatchesChronologicalLog; 
+    static const int EMPTY_SLOT = -1;   // Bye: nobody will ever occupy this slot
+    static const int PENDING_SLOT = -2; // Waiting for the feeder match
+
+    DynamicArray<Player> players;   // Every entrant, sorted by rank when the bracket is initialized
+    int bracketSize;                // Number of entry slots (a power of two)
+    int numRounds;
+
+    int* slotOccupant;              // [2 * bracketSize] player index, EMPTY_SLOT or PENDING_SLOT
+    int* slotMatchId;               // [bracketSize] ID given when the match is released, 0 before that
+    int* readyMatches;              // Released matches still waiting for a result (unordered)
+    int* readyPosition;             // [bracketSize] index into readyMatches, -1 if not waiting
+    int numReady;
+
+    Match currentMatch;             // Reused for every logged result
+    int matchesReleased;
+    int matchesReported;
+    int matchesVoided;
+    bool bracketInitialized;
+    bool loggingResults;
+
+    GameResultLogger& resultLogger;
+    MatchOutcomeModel& outcomeModel;
+    MatchIdSequence& matchIds;
+    SimulationLog& simLog;
+
+    void releaseBracketArrays() {
+        delete[] slotOccupant;
+        delete[] slotMatchId;
+        delete[] readyMatches;
+        delete[] readyPosition;
+        slotOccupant = slotMatchId = readyMatches = readyPosition = nullptr;
+    }
 
-    PlayerStats playerStatsArray[MAX_PLAYERS_UNIVERSAL]; 
-    int numTrackedPlayers;                               
+    // Sends one result, overturn or void for bracket node `node` to the GameResultLogger.
+    void logRecord(int node, int player1, int player2, int winner, MatchRecordType type) {
+        if (!loggingResults) {
+            return;
+        }
+        currentMatch.matchId = slotMatchId[node];
+        currentMatch.round = getRoundOfMatch(node);
+        currentMatch.player1 = players[player1];
+        currentMatch.player2 = players[player2];
+        currentMatch.winner = players[winner];
+        currentMatch.played = true;
+        resultLogger.recordMatchOutcome(currentMatch, type);
+    }
 
-    // Helper to find a player's stats in the array (string playerId)
-    PlayerStats* findPlayerStatsInArray(string playerId) { 
-        for (int i = 0; i < numTrackedPlayers; ++i) {
-            if (playerStatsArray[i].playerId == playerId) {
-                return &playerStatsArray[i];
-            }
+    void removeFromReady(int node) {
+        int position = readyPosition[node];
+        readyMatches[position] = readyMatches[--numReady];
+        readyPosition[readyMatches[position]] = position;
+        readyPosition[node] = -1;
+    }
+
+    void releaseMatch(int node) {
+        slotMatchId[node] = matchIds.next();
+        readyPosition[node] = numReady;
+        readyMatches[numReady++] = node;
+        matchesReleased++;
+        if (simLog.enabled(LogVerbosity::PerMatch)) {
+            simLog.at(LogVerbosity::PerMatch) << "Ready (Round " << getRoundOfMatch(node) << "): Match " << slotMatchId[node] << " | "
+                 << players[slotOccupant[2 * node]].playerName << " vs " << players[slotOccupant[2 * node + 1]].playerName << "\n";
         }
-        return nullptr; // Not found
     }
-    // Const version for read-only access
-    const PlayerStats* findPlayerStatsInArray(string playerId) const { 
-        for (int i = 0; i < numTrackedPlayers; ++i) {
-            if (playerStatsArray[i].playerId == playerId) {
-                return &playerStatsArray[i];
+
+    // Slot `node` has just been decided. Walks up while the parent can be settled: a parent whose
+    // other feeder is a bye is a walkover, a parent with two occupants is released as a match.
+    void slotDecided(int node) {
+        while (node > 1) {
+            int parent = node / 2;
+            int sibling = node ^ 1;
+            if (slotOccupant[sibling] == PENDING_SLOT) {
+                return; // Released later, when the sibling's match reports
+            }
+            if (slotOccupant[node] == EMPTY_SLOT || slotOccupant[sibling] == EMPTY_SLOT) {
+                slotOccupant[parent] = (slotOccupant[node] == EMPTY_SLOT) ? slotOccupant[sibling] : slotOccupant[node];
+                node = parent;
+                continue;
             }
+            releaseMatch(parent);
+            return;
         }
-        return nullptr; // Not found
     }
 
 public:
-    GameResultLogger() : numTrackedPlayers(0) {} 
+    EventDrivenBracket(GameResultLogger& logger, MatchOutcomeModel& model, MatchIdSequence& ids, SimulationLog& log) :
+        players(MAX_PLAYERS_UNIVERSAL), bracketSize(0), numRounds(0),
+        slotOccupant(nullptr), slotMatchId(nullptr), readyMatches(nullptr), readyPosition(nullptr), numReady(0),
+        currentMatch(0), matchesReleased(0), matchesReported(0), matchesVoided(0), bracketInitialized(false), loggingResults(true),
+        resultLogger(logger), outcomeModel(model), matchIds(ids), simLog(log) {}
+
+    ~EventDrivenBracket() {
+        releaseBracketArrays();
+    }
 
-    // Initializes a stats entry for a new player.
-    void initializePlayerForStats(const Player& player) {
-        if (findPlayerStatsInArray(player.playerId) == nullptr) { 
-            if (numTrackedPlayers < MAX_PLAYERS_UNIVERSAL) {
-                playerStatsArray[numTrackedPlayers++] = PlayerStats(player.playerId, player.playerName, player.ranking); 
-            } else {
-                cerr << "Error: Cannot track stats for more players. Max capacity (" << MAX_PLAYERS_UNIVERSAL << ") reached." << endl;
-            }
-        } 
+    // The bracket owns raw arrays, so it is not copyable
+    EventDrivenBracket(const EventDrivenBracket&) = delete;
+    EventDrivenBracket& operator=(const EventDrivenBracket&) = delete;
+
+    // Turns recording into the GameResultLogger on or off (on by default). Set before adding
+    // players; callers that only need advancement (e.g. benchmarks) switch it off.
+    void setResultLogging(bool enabled) {
+        loggingResults = enabled;
     }
 
-    // Records the outcome of a completed match.
-    void recordMatchOutcome(const Match& completedMatch) {
-        if (!completedMatch.played) {
+    // Pre-sizes player storage for large events (optional).
+    void reservePlayers(int expectedPlayers) {
+        players.reserve(expectedPlayers);
+    }
+
+    void addPlayer(const Player& player) {
+        if (bracketInitialized) {
+            cerr << "Error: Cannot add " << player.playerName << " after the event-driven bracket has started." << endl;
             return;
         }
-        if (completedMatch.winner.playerId == "" || completedMatch.winner.playerName == "N/A") { 
-            cerr << "Warning: Match (ID: " << completedMatch.matchId 
-                 << ") outcome is unclear (invalid winner). Performance log update skipped." << endl;
-            return; 
+        players.pushBack(player);
+        if (loggingResults) {
+            resultLogger.initializePlayerForStats(player);
         }
+    }
 
-        HistoricalMatch histMatch(
-            completedMatch.matchId,
-            completedMatch.player1.playerId, completedMatch.player1.playerName, 
-            completedMatch.player2.playerId, completedMatch.player2.playerName, 
-            completedMatch.winner.playerId, completedMatch.winner.playerName    
-        );
-
-        recentMatchesLog.push(histMatch);             
-        allMatchesChronologicalLog.enqueue(histMatch); 
+    int getNumPlayers() const {
+        return players.size();
+    }
 
-        // Update win/loss stats for both participating players using the array
-        PlayerStats* p1Stats = findPlayerStatsInArray(completedMatch.player1.playerId); 
-        PlayerStats* p2Stats = findPlayerStatsInArray(completedMatch.player2.playerId); 
+    // Seeds the entrants by rank into the standard bracket order (1 vs 16, 8 vs 9, ...), gives
+    // byes to the top seeds when the field is not a power of two, and releases every match
+    // whose two entrants are already known.
+    void initializeBracket() {
+        int numPlayers = players.size();
+        mergeSortPlayers(players.data(), numPlayers);
+
+        releaseBracketArrays();
+        bracketSize = 2;
+        numRounds = 1;
+        while (bracketSize < numPlayers) {
+            bracketSize *= 2;
+            numRounds++;
+        }
+        slotOccupant = new int[2 * bracketSize];
+        slotMatchId = new int[bracketSize];
+        readyMatches = new int[bracketSize];
+        readyPosition = new int[bracketSize];
+        for (int node = 0; node < bracketSize; ++node) {
+            slotOccupant[node] = PENDING_SLOT;
+            slotMatchId[node] = 0;
+            readyPosition[node] = -1;
+        }
 
-        if (p1Stats != nullptr) {
-            if (completedMatch.winner.playerId == completedMatch.player1.playerId) { 
-                p1Stats->recordWin();
-            } else {
-                p1Stats->recordLoss();
+        // Seed order for the entry slots, built by doubling: [1,2] -> [1,4,2,3] -> [1,8,4,5,2,7,3,6] ...
+        int* seedOrder = new int[bracketSize];
+        seedOrder[0] = 1;
+        for (int filled = 1; filled < bracketSize; filled *= 2) {
+            for (int k = filled - 1; k >= 0; --k) {
+                seedOrder[2 * k] = seedOrder[k];
+                seedOrder[2 * k + 1] = 2 * filled + 1 - seedOrder[k];
             }
-        } else {
-            cerr << "Warning: Player " << completedMatch.player1.playerName << " (ID: " << completedMatch.player1.playerId 
-                 << ") not found in stats tracking array. Performance not updated." << endl;
         }
-
-        if (p2Stats != nullptr) {
-            if (completedMatch.winner.playerId == completedMatch.player2.playerId) { 
-                p2Stats->recordWin();
+        for (int k = 0; k < bracketSize; ++k) {
+            int seed = seedOrder[k];
+            slotOccupant[bracketSize + k] = (seed <= numPlayers) ? seed - 1 : EMPTY_SLOT;
+        }
+        delete[] seedOrder;
+
+        numReady = 0;
+        matchesReleased = 0;
+        matchesReported = 0;
+        matchesVoided = 0;
+        bracketInitialized = true;
+        simLog.at(LogVerbosity::Summary) << "\n--- Event-Driven Bracket Seeded with " << numPlayers << " Players (" << numRounds << " rounds) ---\n";
+
+        // Children before parents, so byes walk over in the same pass
+        for (int node = bracketSize - 1; node >= 1; --node) {
+            int left = slotOccupant[2 * node];
+            int right = slotOccupant[2 * node + 1];
+            if (left == PENDING_SLOT || right == PENDING_SLOT) {
+                continue;
+            }
+            if (left == EMPTY_SLOT || right == EMPTY_SLOT) {
+                slotOccupant[node] = (left == EMPTY_SLOT) ? right : left;
             } else {
-                p2Stats->recordLoss();
+                releaseMatch(node);
             }
-        } else {
-             cerr << "Warning: Player " << completedMatch.player2.playerName << " (ID: " << completedMatch.player2.playerId 
-                 << ") not found in stats tracking array. Performance not updated." << endl;
         }
     }
 
-    void displayRecentMatches(int numToDisplay = 5) const {
-        int actualDisplayCount = numToDisplay;
-        if (recentMatchesLog.size() < actualDisplayCount) {
-            actualDisplayCount = recentMatchesLog.size();
+    // Matches released but not reported yet, in no particular order.
+    int getNumReadyMatches() const {
+        return numReady;
+    }
+
+    // Bracket node of the i-th ready match; valid until the next reportResult.
+    int getReadyMatch(int readyIndex) const {
+        return readyMatches[readyIndex];
+    }
+
+    bool isReady(int node) const {
+        return node >= 1 && node < bracketSize && readyPosition[node] >= 0;
+    }
+
+    // 1 for the opening round, numRounds for the final.
+    int getRoundOfMatch(int node) const {
+        int depth = 0;
+        while ((node >> (depth + 1)) > 0) {
+            depth++;
         }
-        cout << "\n--- Recent Match Results (Last " << actualDisplayCount << " / " << recentMatchesLog.size() << " Total Recent) ---" << endl;
-        
-        if (recentMatchesLog.isEmpty()) {
-            cout << "No match results have been recorded yet." << endl;
-        } else {
-            CustomStack<HistoricalMatch> tempStack = recentMatchesLog; 
-            int displayedCount = 0;
-            while (!tempStack.isEmpty() && displayedCount < numToDisplay) {
-                cout << tempStack.pop() << endl; 
-                displayedCount++;
-            }
+        return numRounds - depth;
+    }
+
+    // The match at a bracket node, with its two entrants once they are known.
+    Match getMatch(int node) const {
+        Match match(slotMatchId[node]);
+        match.round = getRoundOfMatch(node);
+        if (slotOccupant[2 * node] >= 0) match.player1 = players[slotOccupant[2 * node]];
+        if (slotOccupant[2 * node + 1] >= 0) match.player2 = players[slotOccupant[2 * node + 1]];
+        if (slotOccupant[node] >= 0 && slotMatchId[node] != 0) {
+            match.winner = players[slotOccupant[node]];
+            match.played = true;
         }
-        cout << "--------------------------------------------------------------------" << endl;
+        return match;
     }
 
-    void displayAllRecordedMatches() const {
-        cout << "\n--- All Recorded Matches (" << allMatchesChronologicalLog.size() << " Total) ---" << endl;
-        if (allMatchesChronologicalLog.isEmpty()) {
-            cout << "No matches have been recorded in the chronological log." << endl;
-        } else {
-            CustomQueue<HistoricalMatch> tempQueue = allMatchesChronologicalLog; 
-            int counter = 1;
-            while (!tempQueue.isEmpty()) {
-                cout << counter++ << ". " << tempQueue.dequeue() << endl;
-            }
+    // Reports the result of a ready match, records it and releases whatever it unblocks.
+    // Returns false if the match is not waiting for a result.
+    bool reportResult(int node, bool player1Won) {
+        if (!bracketInitialized || !isReady(node)) {
+            cerr << "Error: Bracket node " << node << " is not waiting for a result." << endl;
+            return false;
         }
-        cout << "--------------------------------------------------------------------" << endl;
+        removeFromReady(node);
+
+        int player1 = slotOccupant[2 * node];
+        int player2 = slotOccupant[2 * node + 1];
+        slotOccupant[node] = player1Won ? player1 : player2;
+        matchesReported++;
+        logRecord(node, player1, player2, slotOccupant[node], MatchRecordType::Result);
+        if (simLog.enabled(LogVerbosity::PerMatch)) {
+            simLog.at(LogVerbosity::PerMatch) << "Result: Match " << slotMatchId[node] << " | " << players[player1].playerName << " vs "
+                 << players[player2].playerName << " -> Winner: " << players[slotOccupant[node]].playerName << "\n";
+        }
+        slotDecided(node);
+        return true;
     }
 
-    void displaySinglePlayerPerformance(string playerId) const { 
-        cout << "\n--- Full Performance Record for Player ID: " << playerId << " ---" << endl;
-        const PlayerStats* playerStats = findPlayerStatsInArray(playerId); 
-        if (playerStats != nullptr) { 
-            cout << *playerStats << endl; 
-            
-            // List all matches involving this player from the chronological log
-            cout << "  Matches involving " << playerStats->playerName << ":" << endl;
-            CustomQueue<HistoricalMatch> tempAllMatches = allMatchesChronologicalLog; 
-            bool foundPlayerMatch = false;
-            int matchCounter = 1;
-            while(!tempAllMatches.isEmpty()){
-                HistoricalMatch currentMatch = tempAllMatches.dequeue();
-                if(currentMatch.player1Id == playerId || currentMatch.player2Id == playerId) { 
-                    cout << "    " << matchCounter++ << ". " << currentMatch << endl;
-                    foundPlayerMatch = true;
+    // Changes the winner of an already reported match. Only the path from that match to the
+    // final is revisited: a later match the old winner had reached is voided (the logger undoes
+    // its win and loss) and released again with the corrected entrant, and everything above it
+    // goes back to waiting. A match that was ready but unplayed simply gets the new entrant.
+    // Returns the number of bracket slots revisited, or -1 if the match has no result to correct.
+    int correctResult(int node, bool player1Won) {
+        if (!bracketInitialized || node < 1 || node >= bracketSize || slotMatchId[node] == 0 ||
+            readyPosition[node] >= 0 || slotOccupant[node] < 0) {
+            cerr << "Error: Bracket node " << node << " has no reported result to correct." << endl;
+            return -1;
+        }
+        int player1 = slotOccupant[2 * node];
+        int player2 = slotOccupant[2 * node + 1];
+        int newWinner = player1Won ? player1 : player2;
+        if (newWinner == slotOccupant[node]) {
+            return 0;
+        }
+        int oldOccupant = slotOccupant[node];
+        slotOccupant[node] = newWinner;
+        logRecord(node, player1, player2, newWinner, MatchRecordType::Overturned);
+        simLog.at(LogVerbosity::PerMatch) << "Correction: Match " << slotMatchId[node] << " winner changed from "
+             << players[oldOccupant].playerName << " to " << players[newWinner].playerName << "\n";
+
+        // Walk up while the slot that just changed feeds something already settled.
+        // `oldOccupant` is who used to sit in slot `changed`; the slot now holds a player or PENDING_SLOT.
+        int slotsTouched = 1;
+        int changed = node;
+        while (changed > 1) {
+            int parent = changed / 2;
+            int sibling = changed ^ 1;
+            int parentOldOccupant = slotOccupant[parent];
+            slotsTouched++;
+            if (slotOccupant[sibling] == EMPTY_SLOT) { // Walkover: the parent simply follows this slot
+                slotOccupant[parent] = slotOccupant[changed];
+            } else if (readyPosition[parent] >= 0) { // Released, not played yet
+                if (slotOccupant[changed] == PENDING_SLOT) {
+                    removeFromReady(parent);
+                    slotMatchId[parent] = 0;
+                }
+                break;
+            } else if (parentOldOccupant == PENDING_SLOT) { // Still waiting on the sibling
+                break;
+            } else { // Played with the old entrant: withdraw the result
+                int oldPlayer1 = (changed == 2 * parent) ? oldOccupant : slotOccupant[sibling];
+                int oldPlayer2 = (changed == 2 * parent) ? slotOccupant[sibling] : oldOccupant;
+                logRecord(parent, oldPlayer1, oldPlayer2, parentOldOccupant, MatchRecordType::Voided);
+                simLog.at(LogVerbosity::PerMatch) << "Voided: Match " << slotMatchId[parent] << " (" << players[oldPlayer1].playerName
+                     << " vs " << players[oldPlayer2].playerName << ") must be replayed\n";
+                matchesVoided++;
+                slotOccupant[parent] = PENDING_SLOT;
+                slotMatchId[parent] = 0;
+                if (slotOccupant[changed] != PENDING_SLOT) {
+                    releaseMatch(parent); // Replay with the corrected entrant under a new match ID
                 }
             }
-            if(!foundPlayerMatch) {
-                cout << "    No specific match records found in the log for this player." << endl;
-            }
-        } else {
-            cout << "Player with ID " << playerId << " not found or no stats recorded for them." << endl;
+            oldOccupant = parentOldOccupant;
+            changed = parent;
         }
-        cout << "--------------------------------------------------------------------" << endl;
+        return slotsTouched;
     }
 
-    void displayAllPlayersPerformanceSummary() const {
-        cout << "\n--- All Player Performance Summaries (" << numTrackedPlayers << " Players Tracked) ---" << endl;
-        if (numTrackedPlayers == 0) { // Typo fix: numTrackers -> numTrackedPlayers
-            cout << "No player performance data available." << endl;
-        } else {
-            for (int i = 0; i < numTrackedPlayers; ++i) {
-                cout << playerStatsArray[i] << endl;
+    // Simulates matches finishing in an arbitrary order: repeatedly picks one of the ready
+    // matches at random, resolves it with the outcome model and reports it.
+    void runToCompletion() {
+#ifdef TOURNAMENT_METRICS
+        // Rounds overlap here, so each is timed from its first match picked to its last result
+        chrono::steady_clock::time_point* roundStart = new chrono::steady_clock::time_point[numRounds + 1];
+        chrono::steady_clock::time_point* roundEnd = new chrono::steady_clock::time_point[numRounds + 1];
+        bool* roundPlayed = new bool[numRounds + 1]();
+#endif
+        while (numReady > 0) {
+            int node = readyMatches[outcomeModel.nextSeed() % static_cast<unsigned long long>(numReady)];
+#ifdef TOURNAMENT_METRICS
+            int round = getRoundOfMatch(node);
+            if (!roundPlayed[round]) {
+                roundStart[round] = chrono::steady_clock::now();
+                roundPlayed[round] = true;
             }
+#endif
+            reportResult(node, outcomeModel.player1Wins());
+#ifdef TOURNAMENT_METRICS
+            roundEnd[round] = chrono::steady_clock::now();
+#endif
         }
-        cout << "--------------------------------------------------------------------" << endl;
+#ifdef TOURNAMENT_METRICS
+        for (int round = 1; round <= numRounds; ++round) {
+            if (roundPlayed[round]) {
+                chrono::duration<double> elapsed = roundEnd[round] - roundStart[round];
+                TournamentMetrics::recordRound("event_driven_bracket", round, elapsed.count());
+            }
+        }
+        delete[] roundStart;
+        delete[] roundEnd;
+        delete[] roundPlayed;
+#endif
     }
-};
-
-
-// --- MatchScheduler Class (from original tournament system) ---
-class MatchScheduler {
-private:
-    Player initialPlayers[MAX_PLAYERS_UNIVERSAL]; // Array to store all initially added players
-    int numInitialPlayers;                        // Count of players in initialPlayers
 
-    CustomQueue<Player> waitingPlayersQueue; 
-    CustomQueue<Match> scheduledMatchesQueue; 
-    CustomQueue<Player> winnersQueue;         
-    
-    GameResultLogger& resultLogger; 
-
-    // Helper to sort players by rank (lower rank is better)
-    void sortPlayersByRank(Player arr[], int n) {
-        insertionSortPlayers(arr, n); 
+    bool isTournamentOver() const {
+        return bracketInitialized && (players.size() == 0 || slotOccupant[1] >= 0);
     }
 
-    // Helper struct for group stage results, for sorting
-    struct GroupPlayerResult {
-        Player player;
-        int groupWins;
-    };
-
-    // Custom Insertion Sort for GroupPlayerResult (sort by wins desc, then rank asc)
-    void insertionSortGroupResults(GroupPlayerResult arr[], int n) {
-        for (int i = 1; i < n; ++i) {
-            GroupPlayerResult key = arr[i];
-            int j = i - 1;
+    int getBracketSize() const { return bracketSize; }
+    int getNumRounds() const { return numRounds; }
+    int getMatchId(int node) const { return slotMatchId[node]; } // 0 for byes and unreleased matches
+    int getMatchesReleased() const { return matchesReleased; }
+    int getMatchesReported() const { return matchesReported; }
+    int getMatchesVoided() const { return matchesVoided; }
 
-            while (j >= 0 && (arr[j].groupWins < key.groupWins || (arr[j].groupWins == key.groupWins && arr[j].player.ranking > key.player.ranking))) {
-                arr[j + 1] = arr[j];
-                j = j - 1;
-            }
-            arr[j + 1] = key;
+    const Player& getTournamentWinner() const {
+        if (bracketInitialized && slotOccupant[1] >= 0) {
+            return players[slotOccupant[1]];
         }
+        return Player::none();
     }
+};
 
-public:
-    MatchScheduler(GameResultLogger& logger) : numInitialPlayers(0), resultLogger(logger) {}
+// --- TournamentCheckpoint ---
+// Crash recovery for the main bracket. The checkpoint file is a journal:
+//   header:  "TNCK" + format version
+//   frames:  [type][payload length][payload][FNV-1a checksum of the payload]
+// The first frame ('R') holds the tracked player roster. Every round boundary appends a
+// bracket frame ('B') with the round number, match ID counter, generator state, the three
+// scheduler queues and only the matches logged since the previous frame. Stats are rebuilt
+// by replaying the match log, so writing a frame costs time proportional to that round,
+// not to the whole event. Loading stops at the first damaged or half-written frame and
+// resumes from the last complete one.
+struct CheckpointRoundInfo {
+    int roundNumber;       // Next main bracket round to play
+    int bracketFormat;     // Menu choice from main (single / pipelined)
+    int numPlayersInEvent; // Players transferred to the scheduler in Phase 2
+};
 
-    // Adds a player to the tournament and initializes them for stats tracking.
-    void addPlayer(const Player& player) {
-        if (numInitialPlayers < MAX_PLAYERS_UNIVERSAL) {
-            // Prevent adding player with duplicate ID (if IDs are read from CSV)
-            for(int i=0; i < numInitialPlayers; ++i) {
-                if(initialPlayers[i].playerId == player.playerId) { // Changed player.id to player.playerId
-                    cerr << "Error: Player with ID " << player.playerId << " (" << initialPlayers[i].playerName 
-                         << ") already exists. Cannot add " << player.playerName << " with the same ID." << endl;
-                    return; // Skip adding this player
-                }
-            }
-            initialPlayers[numInitialPlayers++] = player;
-            resultLogger.initializePlayerForStats(player); 
-        } else {
-            cerr << "Error: Cannot add more players. Maximum capacity (" << MAX_PLAYERS_UNIVERSAL << ") reached." << endl;
+class TournamentCheckpoint {
+private:
+    string filePath;
+    ofstream journal;
+    bool rosterWritten;
+    CheckpointWriter payload;
+
+    static const unsigned char ROSTER_FRAME = 'R';
+    static const unsigned char BRACKET_FRAME = 'B';
+    static const unsigned int FORMAT_VERSION = 4; // 2: log entries carry their MatchRecordType; 3: round and group; 4: starting ratings
+
+    static unsigned long long checksum(const char* data, size_t size) {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 1099511628211ULL;
         }
+        return hash;
     }
-    
-    int getNumInitialPlayers() const { 
-        return numInitialPlayers;
+
+    static void writeFrame(ostream& out, unsigned char type, const string& bytes) {
+        unsigned int length = static_cast<unsigned int>(bytes.size());
+        unsigned long long sum = checksum(bytes.data(), bytes.size());
+        out.put(static_cast<char>(type));
+        out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+        out.write(bytes.data(), bytes.size());
+        out.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
     }
 
-    // Initializes the tournament by sorting all initial players.
-    void initializeTournament() {
-        if (numInitialPlayers == 0) {
-            cout << "No players added to the tournament to initialize." << endl;
-            return;
+    void buildRosterPayload(const GameResultLogger& logger) {
+        payload.clear();
+        payload.writeUInt32(static_cast<unsigned int>(logger.getNumTrackedPlayers()));
+        for (int i = 0; i < logger.getNumTrackedPlayers(); ++i) {
+            const PlayerStats& stats = logger.getTrackedPlayerStats(i);
+            payload.writeString(stats.playerId);
+            payload.writeString(stats.playerName);
+            payload.writeInt32(stats.initialRank);
+            payload.writeDouble(stats.startingRating); // Ratings are replayed from here with the log
         }
+    }
 
-        // Sort all registered players by rank
-        sortPlayersByRank(initialPlayers, numInitialPlayers); 
-        cout << "\n--- All " << numInitialPlayers << " Players Sorted by Rank (Initial Seeding) ---" << endl;
-        for (int i = 0; i < numInitialPlayers; ++i) {
-            cout << (i + 1) << ". " << initialPlayers[i].playerName << " (Rank: " << initialPlayers[i].ranking << ", Type: " << initialPlayers[i].originalPriority << ")" << endl;
+    void buildBracketPayload(const MatchScheduler& scheduler, const GameResultLogger& logger,
+                             const MatchOutcomeModel& model, const CheckpointRoundInfo& info) {
+        payload.clear();
+        payload.writeInt32(info.roundNumber);
+        payload.writeInt32(info.bracketFormat);
+        payload.writeInt32(info.numPlayersInEvent);
+        payload.writeInt32(scheduler.getMatchIds().peekNext());
+        payload.writeUInt64(model.getState());
+        // New log entries come before the queues so older frames can be replayed without parsing the rest
+        const DynamicArray<HistoricalMatch>& newMatches = logger.getUnsavedMatches();
+        payload.writeUInt32(static_cast<unsigned int>(newMatches.size()));
+        for (int i = 0; i < newMatches.size(); ++i) {
+            payload.writeHistoricalMatch(newMatches[i]);
         }
-        cout << "------------------------------------" << endl;
+        scheduler.writeBracketState(payload);
     }
 
-    // Group Stage Method
-    void runGroupStage(int numGroups) {
-        if (numGroups <= 0) {
-            cerr << "Error: Number of groups must be positive for group stage." << endl;
-            return;
-        }
-        
-        // Expected players for full group stage: 6 * 4 + 10 * 4 = 24 + 40 = 64
-        if (numInitialPlayers < (6 * 4 + 10 * 4)) { 
-            cerr << "Warning: Not enough players (" << numInitialPlayers 
-                 << ") to form " << numGroups << " groups with required compositions. Skipping group stage or adjusting." << endl;
-            // If there's only one player after initialization, they are the champion.
-            if (numInitialPlayers == 1) {
-                winnersQueue.enqueue(initialPlayers[0]);
-                cout << initialPlayers[0].playerName << " is the sole player and advances directly as the champion after group stage." << endl;
-            } else if (numInitialPlayers > 0) {
-                // If there are players but not enough for full groups,
-                // just advance all available players directly to the main bracket.
-                cout << "Not enough players for proper group stage. Advancing all " << numInitialPlayers << " players directly to main bracket." << endl;
-                for (int i = 0; i < numInitialPlayers; ++i) {
-                    winnersQueue.enqueue(initialPlayers[i]);
-                }
+public:
+    TournamentCheckpoint(const string& path) : filePath(path), rosterWritten(false) {}
+
+    // Appends a frame for the current round boundary. The first call writes a fresh file
+    // (header, roster and first frame) next to the old one and swaps it in.
+    // GameResultLogger journaling must be on from the start of the event.
+    bool saveRound(const MatchScheduler& scheduler, GameResultLogger& logger,
+                   const MatchOutcomeModel& model, const CheckpointRoundInfo& info) {
+        if (!rosterWritten) {
+            string tempPath = filePath + ".tmp";
+            ofstream fresh(tempPath, ios::binary | ios::trunc);
+            if (!fresh.is_open()) {
+                cerr << "Error: Unable to create checkpoint file: " << tempPath << endl;
+                return false;
             }
-            return;
-        }
-        
-        cout << "\n--- Group Division: Starting Group Stage with " << numGroups << " Groups ---" << endl;
-
-        // Categorize players into temporary queues based on registration type
-        // Players are drawn from initialPlayers, which is already sorted by rank (strongest first)
-        CustomQueue<Player> earlyBirdsQ;
-        CustomQueue<Player> regularsQ;
-        CustomQueue<Player> wildcardsQ;
-
-        for (int i = 0; i < numInitialPlayers; ++i) {
-            if (initialPlayers[i].originalPriority == "early birds") { // Use exact string from CSV
-                earlyBirdsQ.enqueue(initialPlayers[i]);
-            } else if (initialPlayers[i].originalPriority == "regular") { // Use exact string from CSV
-                regularsQ.enqueue(initialPlayers[i]);
-            } else if (initialPlayers[i].originalPriority == "wildcard") { // Use exact string from CSV
-                wildcardsQ.enqueue(initialPlayers[i]);
-            } else {
-                cerr << "Warning: Unknown original priority for player: " << initialPlayers[i].playerName << " ('" << initialPlayers[i].originalPriority << "'). Skipping for group stage." << endl;
+            unsigned int version = FORMAT_VERSION;
+            fresh.write("TNCK", 4);
+            fresh.write(reinterpret_cast<const char*>(&version), sizeof(version));
+            buildRosterPayload(logger);
+            writeFrame(fresh, ROSTER_FRAME, payload.data());
+            buildBracketPayload(scheduler, logger, model, info);
+            writeFrame(fresh, BRACKET_FRAME, payload.data());
+            fresh.close();
+            if (fresh.fail()) {
+                cerr << "Error: Failed writing checkpoint file: " << tempPath << endl;
+                return false;
             }
-        }
-
-        // Array of queues for groups (max 16 groups)
-        CustomQueue<Player> groupQueues[16]; 
-        int currentGroupIndex = 0;
-
-        // Form 6 groups of (1 early bird, 2 regular, 1 wildcard)
-        for (int i = 0; i < 6; ++i) {
-            if (earlyBirdsQ.isEmpty() || regularsQ.size() < 2 || wildcardsQ.isEmpty()) {
-                cerr << "Error: Not enough players for specific group composition (1 Early Bird, 2 Regular, 1 Wildcard) for group " << (i + 1) << ". Cannot complete group stage." << endl;
-                // Enqueue remaining players to winnersQueue if group stage cannot complete
-                while(!earlyBirdsQ.isEmpty()) winnersQueue.enqueue(earlyBirdsQ.dequeue());
-                while(!regularsQ.isEmpty()) winnersQueue.enqueue(regularsQ.dequeue());
-                while(!wildcardsQ.isEmpty()) winnersQueue.enqueue(wildcardsQ.dequeue());
-                return; 
+            remove(filePath.c_str());
+            if (rename(tempPath.c_str(), filePath.c_str()) != 0) {
+                cerr << "Error: Unable to replace checkpoint file: " << filePath << endl;
+                return false;
             }
-            groupQueues[currentGroupIndex].enqueue(earlyBirdsQ.dequeue());
-            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
-            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
-            groupQueues[currentGroupIndex].enqueue(wildcardsQ.dequeue());
-            cout << "  Group " << (currentGroupIndex + 1) << " formed (1 Early Bird, 2 Regular, 1 Wildcard)." << endl;
-            currentGroupIndex++;
+            journal.open(filePath, ios::binary | ios::app);
+            rosterWritten = true;
+        } else {
+            buildBracketPayload(scheduler, logger, model, info);
+            writeFrame(journal, BRACKET_FRAME, payload.data());
+            journal.flush();
         }
+        logger.clearUnsavedMatches();
+        return journal.good();
+    }
 
-        // Form 10 groups of (1 early bird, 3 regular)
-        for (int i = 0; i < 10; ++i) {
-            if (earlyBirdsQ.isEmpty() || regularsQ.size() < 3) {
-                cerr << "Error: Not enough players for specific group composition (1 Early Bird, 3 Regular) for group " << (i + 1) << ". Cannot complete group stage." << endl;
-                // Enqueue remaining players to winnersQueue if group stage cannot complete
-                while(!earlyBirdsQ.isEmpty()) winnersQueue.enqueue(earlyBirdsQ.dequeue());
-                while(!regularsQ.isEmpty()) winnersQueue.enqueue(regularsQ.dequeue());
-                while(!wildcardsQ.isEmpty()) winnersQueue.enqueue(wildcardsQ.dequeue());
-                return;
-            }
-            groupQueues[currentGroupIndex].enqueue(earlyBirdsQ.dequeue());
-            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
-            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
-            groupQueues[currentGroupIndex].enqueue(regularsQ.dequeue());
-            cout << "  Group " << (currentGroupIndex + 1) << " formed (1 Early Bird, 3 Regular)." << endl;
-            currentGroupIndex++;
+    // Rebuilds scheduler queues, logger history and stats, the match ID counter and the
+    // generator state from the last complete frame in `path`. The logger must be empty.
+    // Returns false (leaving a message on cerr) when the file has no usable frame.
+    static bool load(const string& path, MatchScheduler& scheduler, GameResultLogger& logger,
+                     MatchOutcomeModel& model, CheckpointRoundInfo& info) {
+        ifstream file(path, ios::binary);
+        if (!file.is_open()) {
+            cerr << "Error: Unable to open checkpoint file: " << path << endl;
+            return false;
+        }
+        string contents((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+        unsigned int version = 0;
+        if (contents.size() < 8 || contents.compare(0, 4, "TNCK") != 0) {
+            cerr << "Error: " << path << " is not a tournament checkpoint file." << endl;
+            return false;
+        }
+        memcpy(&version, contents.data() + 4, sizeof(version));
+        if (version != FORMAT_VERSION) {
+            cerr << "Error: Unsupported checkpoint version " << version << "." << endl;
+            return false;
         }
 
-        // Process each group: play matches and determine top 2
-        int playersAdvancedFromGroupStage = 0;
-        for (int i = 0; i < currentGroupIndex; ++i) { // Iterate through the 16 formed groups
-            cout << "\n--- Processing Group " << (i + 1) << " ---" << endl;
-            
-            if (groupQueues[i].size() != 4) { 
-                cerr << "Fatal Error: Group " << (i + 1) << " does not have exactly 4 players (" << groupQueues[i].size() << "). This should not happen if player counts are correct. Cannot run matches for this group." << endl;
-                while (!groupQueues[i].isEmpty()) groupQueues[i].dequeue(); // Clear the group
-                continue; 
+        // First pass: find the complete frames
+        const size_t frameOverhead = 1 + sizeof(unsigned int) + sizeof(unsigned long long);
+        DynamicArray<size_t> frameStarts;
+        size_t position = 8;
+        while (contents.size() - position >= frameOverhead) {
+            unsigned int length;
+            memcpy(&length, contents.data() + position + 1, sizeof(length));
+            if (contents.size() - position - frameOverhead < length) {
+                break; // Half-written frame
             }
-
-            Player groupPlayersArray[4];
-            for (int k = 0; k < 4; ++k) {
-                groupPlayersArray[k] = groupQueues[i].dequeue();
+            const char* frameData = contents.data() + position + 1 + sizeof(length);
+            unsigned long long storedSum;
+            memcpy(&storedSum, frameData + length, sizeof(storedSum));
+            if (storedSum != checksum(frameData, length)) {
+                cerr << "Warning: Checkpoint frame at byte " << position << " is damaged. Resuming from the frame before it." << endl;
+                break;
             }
+            frameStarts.pushBack(position);
+            position += frameOverhead + length;
+        }
+        if (frameStarts.size() < 2 || contents[frameStarts[0]] != static_cast<char>(ROSTER_FRAME)) {
+            cerr << "Error: Checkpoint file " << path << " has no complete round to resume from." << endl;
+            return false;
+        }
 
-            // Initialize local group win tracking
-            GroupPlayerResult groupResults[4];
-            for (int k = 0; k < 4; ++k) {
-                groupResults[k] = {groupPlayersArray[k], 0};
-            }
-
-            // Simulate matches for 4 games per player within the group
-            // Total matches per group = 4 players * 4 games / 2 players per match = 8 matches
-            int matchPairings[8][2] = {
-                {0,1}, {2,3}, // First set of matches
-                {0,2}, {1,3}, // Second set
-                {0,3}, {1,2}, // Third set
-                {0,1}, {2,3}  // Rematches for 4th game per player (P0,P1 play again; P2,P3 play again)
-            };
-
-            for (int p = 0; p < 8; ++p) {
-                Player p1 = groupPlayersArray[matchPairings[p][0]];
-                Player p2 = groupPlayersArray[matchPairings[p][1]];
-                Match currentMatch(p1, p2);
-                
-                // Simulate match outcome: RANDOMLY (50/50 chance for either player)
-                if (rand() % 2 == 0) { 
-                    currentMatch.winner = currentMatch.player1;
-                } else { 
-                    currentMatch.winner = currentMatch.player2;
+        // Second pass: roster, every frame's new matches, then the last frame's bracket state
+        try {
+            for (int f = 0; f < frameStarts.size(); ++f) {
+                unsigned int length;
+                memcpy(&length, contents.data() + frameStarts[f] + 1, sizeof(length));
+                CheckpointReader in(contents.data() + frameStarts[f] + 1 + sizeof(length), length);
+                if (f == 0) {
+                    unsigned int numPlayers = in.readUInt32();
+                    for (unsigned int i = 0; i < numPlayers; ++i) {
+                        string id = in.readString();
+                        string name = in.readString();
+                        int rank = in.readInt32();
+                        double startingRating = in.readDouble();
+                        logger.restoreTrackedPlayer(PlayerStats(id, name, rank, startingRating));
+                    }
+                    continue;
+                }
+                info.roundNumber = in.readInt32();
+                info.bracketFormat = in.readInt32();
+                info.numPlayersInEvent = in.readInt32();
+                int nextMatchId = in.readInt32();
+                unsigned long long rngState = in.readUInt64();
+                unsigned int numNewMatches = in.readUInt32();
+                for (unsigned int i = 0; i < numNewMatches; ++i) {
+                    logger.restoreMatchRecord(in.readHistoricalMatch(), true);
                 }
-                currentMatch.played = true; 
-                resultLogger.recordMatchOutcome(currentMatch); // Record for logging
-
-                // Update group stage wins
-                for(int k=0; k<4; ++k) {
-                    if(groupResults[k].player.playerId == currentMatch.winner.playerId) { 
-                        groupResults[k].groupWins++;
-                        break; 
-                    }
+                if (f == frameStarts.size() - 1) {
+                    scheduler.readBracketState(in);
+                    scheduler.getMatchIds().restore(nextMatchId);
+                    scheduler.setNextBracketRound(info.roundNumber);
+                    model.reseed(rngState);
                 }
-                cout << "  Match: " << currentMatch.player1.playerName << " vs " << currentMatch.player2.playerName
-                     << " -> Winner: " << currentMatch.winner.playerName << endl;
             }
+        } catch (const runtime_error& e) {
+            cerr << "Error: Checkpoint file " << path << " is inconsistent: " << e.what() << endl;
+            return false;
+        }
+        return true;
+    }
+};
 
-            // Determine Top 2 from the group
-            insertionSortGroupResults(groupResults, 4); // Sort by group wins (desc), then rank (asc)
+// --- WorkStealingPool ---
+// Fixed set of worker threads, each with its own mutex-guarded task deque. Submitted tasks are
+// spread round-robin over the deques; a worker runs its own tasks oldest first and, once its
+// deque is empty, steals the newest task from another worker. Uneven tasks (a 16-player
+// regional next to a 1,000-player open) therefore do not leave cores idle.
+class WorkStealingPool {
+public:
+    typedef function<void()> Task;
 
-            cout << "  Group " << (i + 1) << " Standings (Top 2 advance):" << endl;
-            for(int k=0; k<4; ++k) {
-                cout << "    " << (k+1) << ". " << groupResults[k].player.playerName << " (Group Wins: " << groupResults[k].groupWins << ")" << endl;
+private:
+    // Growable ring of tasks. The owner pops the front, thieves pop the back.
+    class TaskDeque {
+    private:
+        Task* slots;
+        int capacity;
+        int head;
+        int count;
+
+        void grow() {
+            int newCapacity = capacity * 2;
+            Task* newSlots = new Task[newCapacity];
+            for (int i = 0; i < count; ++i) {
+                newSlots[i] = std::move(slots[(head + i) % capacity]);
             }
-
-            // Enqueue top 2 players to winnersQueue
-            winnersQueue.enqueue(groupResults[0].player);
-            playersAdvancedFromGroupStage++;
-            winnersQueue.enqueue(groupResults[1].player);
-            playersAdvancedFromGroupStage++;
-            cout << "  " << groupResults[0].player.playerName << " and " << groupResults[1].player.playerName << " advance from Group " << (i+1) << "." << endl;
+            delete[] slots;
+            slots = newSlots;
+            capacity = newCapacity;
+            head = 0;
         }
-        cout << "\n--- Group Stage Complete. " << playersAdvancedFromGroupStage << " players advanced to main bracket. ---" << endl;
-    }
 
+    public:
+        mutex lock;
 
-    // Creates match pairings for the next round from players in waitingPlayersQueue.
-    bool createNextRoundPairings() {
-        if (waitingPlayersQueue.size() < 2) {
-            return false; 
-        }
+        TaskDeque() : slots(new Task[16]), capacity(16), head(0), count(0) {}
+        ~TaskDeque() { delete[] slots; }
 
-        cout << "\n--- Creating Pairings for Next Round ---" << endl;
+        TaskDeque(const TaskDeque&) = delete;
+        TaskDeque& operator=(const TaskDeque&) = delete;
 
-        // Extract players from waiting queue to a temporary array for pairing logic
-        Player roundPlayersArray[MAX_PLAYERS_UNIVERSAL];
-        int numRoundPlayers = 0;
-        while(!waitingPlayersQueue.isEmpty() && numRoundPlayers < MAX_PLAYERS_UNIVERSAL) {
-            roundPlayersArray[numRoundPlayers++] = waitingPlayersQueue.dequeue();
+        void pushBack(Task&& task) {
+            if (count == capacity) {
+                grow();
+            }
+            slots[(head + count) % capacity] = std::move(task);
+            count++;
         }
-        
-        // Ensure players are sorted by rank before pairing for next round
-        sortPlayersByRank(roundPlayersArray, numRoundPlayers);
 
-        int i = 0, j = numRoundPlayers - 1;
-        while (i < j) {
-            Match newMatch(roundPlayersArray[i], roundPlayersArray[j]);
-            scheduledMatchesQueue.enqueue(newMatch);
-            cout << "Scheduled: " << newMatch.player1.playerName << " (Rank: " << newMatch.player1.ranking << ") vs " << newMatch.player2.playerName << " (Rank: " << newMatch.player2.ranking << ")" << endl;
-            i++;
-            j--;
+        bool popFront(Task& out) {
+            if (count == 0) {
+                return false;
+            }
+            out = std::move(slots[head]);
+            head = (head + 1) % capacity;
+            count--;
+            return true;
         }
 
-        if (i == j) { // One player remains in the middle - receives a bye
-            Player byePlayer = roundPlayersArray[i];
-            cout << byePlayer.playerName << " gets a BYE and advances directly to the winners' pool." << endl;
-            winnersQueue.enqueue(byePlayer); 
+        bool popBack(Task& out) {
+            if (count == 0) {
+                return false;
+            }
+            out = std::move(slots[(head + count - 1) % capacity]);
+            count--;
+            return true;
         }
-        cout << "------------------------------------" << endl;
-        return !scheduledMatchesQueue.isEmpty() || (numRoundPlayers > 0 && i == j);
-    }
+    };
 
-    // Simulates playing scheduled matches and processes their outcomes.
-    void playAndProcessMatches() {
-        if (scheduledMatchesQueue.isEmpty()) {
-            return; 
+    int numWorkers;
+    TaskDeque* deques;
+    thread* workers;
+    atomic<int> queuedTasks;  // Sitting in a deque
+    atomic<int> pendingTasks; // Queued or running
+    atomic<unsigned int> nextDeque;
+    atomic<long long> stealCount;
+    mutex stateMutex;
+    condition_variable workAvailable;
+    condition_variable allIdle;
+    bool stopping;
+
+    bool takeTask(int self, Task& out) {
+        {
+            lock_guard<mutex> guard(deques[self].lock);
+            if (deques[self].popFront(out)) {
+                queuedTasks--;
+                return true;
+            }
         }
-        
-        cout << "\n--- Playing and Processing Matches ---" << endl;
-        while (!scheduledMatchesQueue.isEmpty()) {
-            Match currentMatch = scheduledMatchesQueue.dequeue();
-
-            if (rand() % 2 == 0) { 
-                currentMatch.winner = currentMatch.player1;
-            } else { 
-                currentMatch.winner = currentMatch.player2;
+        for (int k = 1; k < numWorkers; ++k) {
+            TaskDeque& victim = deques[(self + k) % numWorkers];
+            lock_guard<mutex> guard(victim.lock);
+            if (victim.popBack(out)) {
+                queuedTasks--;
+                stealCount++;
+                return true;
             }
-            currentMatch.played = true;
-
-            cout << currentMatch.player1.playerName << " vs " << currentMatch.player2.playerName
-                 << " -> Winner: " << currentMatch.winner.playerName << endl;
-            
-            resultLogger.recordMatchOutcome(currentMatch); 
+        }
+        return false;
+    }
 
-            winnersQueue.enqueue(currentMatch.winner); 
+    void workerLoop(int self) {
+        Task task;
+        while (true) {
+            if (takeTask(self, task)) {
+                task();
+                task = nullptr; // Release captured state before reporting completion
+                if (--pendingTasks == 0) {
+                    lock_guard<mutex> guard(stateMutex);
+                    allIdle.notify_all();
+                }
+                continue;
+            }
+            unique_lock<mutex> guard(stateMutex);
+            workAvailable.wait(guard, [this]() { return stopping || queuedTasks.load() > 0; });
+            if (stopping && queuedTasks.load() == 0) {
+                return;
+            }
         }
-        cout << "------------------------------------" << endl;
     }
 
-    // Advances winners from the winnersQueue to the waitingPlayersQueue for the next round.
-    bool advanceToNextRound() {
-        if (winnersQueue.isEmpty() && waitingPlayersQueue.isEmpty()) {
-            return false;
+public:
+    WorkStealingPool(int threads) :
+        numWorkers(threads > 0 ? threads : 1), queuedTasks(0), pendingTasks(0), nextDeque(0), stealCount(0), stopping(false) {
+        deques = new TaskDeque[numWorkers];
+        workers = new thread[numWorkers];
+        for (int w = 0; w < numWorkers; ++w) {
+            workers[w] = thread(&WorkStealingPool::workerLoop, this, w);
         }
+    }
 
-        if (winnersQueue.size() == 1 && waitingPlayersQueue.isEmpty() && scheduledMatchesQueue.isEmpty()) {
-            Player finalWinnerCandidate = winnersQueue.peek(); 
-            waitingPlayersQueue.enqueue(winnersQueue.dequeue()); 
-            cout << "\n--- Advancing Final Player ---" << endl;
-            cout << finalWinnerCandidate.playerName << " is the sole remaining player." << endl;
-            cout << "------------------------------------" << endl;
-            return false; 
+    // Finishes every queued task, then joins the workers.
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> guard(stateMutex);
+            stopping = true;
         }
-        
-        cout << "\n--- Advancing Winners to Next Round's Waiting Pool ---" << endl;
-        while (!winnersQueue.isEmpty()) {
-            Player winnerToAdvance = winnersQueue.dequeue();
-            waitingPlayersQueue.enqueue(winnerToAdvance);
-            cout << winnerToAdvance.playerName << " advances." << endl;
+        workAvailable.notify_all();
+        for (int w = 0; w < numWorkers; ++w) {
+            workers[w].join();
         }
-        cout << "------------------------------------" << endl;
-
-        return waitingPlayersQueue.size() >= 1; 
+        delete[] workers;
+        delete[] deques;
     }
 
-    // Display functions for queues (mostly for debugging)
-    void displayScheduledMatches() const { 
-        cout << "\n--- Current Scheduled Matches (" << scheduledMatchesQueue.size() << ") ---" << endl;
-        if (scheduledMatchesQueue.isEmpty()) {
-            cout << "No matches currently scheduled." << endl;
-        } else {
-            CustomQueue<Match> tempQueue = scheduledMatchesQueue; 
-            while (!tempQueue.isEmpty()) {
-                cout << tempQueue.dequeue() << endl;
-            }
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Task task) {
+        int target = static_cast<int>(nextDeque++ % static_cast<unsigned int>(numWorkers));
+        pendingTasks++;
+        {
+            lock_guard<mutex> guard(deques[target].lock);
+            deques[target].pushBack(std::move(task));
         }
-        cout << "------------------------------------" << endl;
+        queuedTasks++;
+        lock_guard<mutex> guard(stateMutex);
+        workAvailable.notify_one();
     }
-    void displayWaitingPlayers() const { 
-        cout << "\n--- Players Waiting for Next Round (" << waitingPlayersQueue.size() << ") ---" << endl;
-        if (waitingPlayersQueue.isEmpty()) {
-            cout << "No players currently waiting." << endl;
-        } else {
-            CustomQueue<Player> tempQueue = waitingPlayersQueue; 
-            while (!tempQueue.isEmpty()) {
-                cout << tempQueue.dequeue() << endl;
-            }
-        }
-        cout << "------------------------------------" << endl;    
+
+    // Blocks until every submitted task has finished.
+    void waitIdle() {
+        unique_lock<mutex> guard(stateMutex);
+        allIdle.wait(guard, [this]() { return pendingTasks.load() == 0; });
     }
-    void displayWinners() const { 
-        cout << "\n--- Winners from Last Played Round (Before Advancing) (" << winnersQueue.size() << ") ---" << endl;
-        if (winnersQueue.isEmpty()) {
-            cout << "No winners recorded from the last round / No matches played yet / Winners already advanced." << endl;
+
+    int getNumWorkers() const { return numWorkers; }
+    long long getStealCount() const { return stealCount.load(); }
+};
+
+// --- TournamentHost ---
+// One independent event run by TournamentHost. Results are filled in once the event has run.
+struct HostedTournament {
+    string name;
+    DynamicArray<Player> roster;
+    unsigned long long seed;
+    int bracketFormat; // 1 = single elimination, 2 = double elimination
+    Player champion;
+    int matchesPlayed;
+    double latencyMs;  // From TournamentHost::runAll starting to this event finishing
+    double runMs;      // Time spent simulating this event
+
+    HostedTournament() : seed(0), bracketFormat(1), matchesPlayed(0), latencyMs(0.0), runMs(0.0) {}
+};
+
+// Runs many tournaments at once on a WorkStealingPool. Every event gets its own logger,
+// outcome model, match numbering and (silent) simulation log, so nothing is shared between them.
+class TournamentHost {
+private:
+    WorkStealingPool pool;
+    DynamicArray<HostedTournament> events;
+    double wallMs;
+
+    static double elapsedMs(chrono::steady_clock::time_point from, chrono::steady_clock::time_point to) {
+        return chrono::duration<double, milli>(to - from).count();
+    }
+
+    // League group stage (groups of 4, top 2 advance) followed by the main bracket.
+    static void runTournament(HostedTournament& event) {
+        GameResultLogger logger;
+        MatchOutcomeModel model(event.seed);
+        MatchIdSequence matchIds;
+        SimulationLog log(LogVerbosity::Silent, 4096);
+        MatchScheduler scheduler(logger, model, matchIds, log);
+        for (int i = 0; i < event.roster.size(); ++i) {
+            scheduler.addPlayer(event.roster[i]);
+        }
+        scheduler.initializeTournament();
+        if (scheduler.getNumInitialPlayers() > 1) {
+            scheduler.runLeagueGroupStage(4, false, 2, 1);
+            scheduler.advanceToNextRound();
+        }
+
+        if (event.bracketFormat == 2) {
+            DoubleEliminationScheduler doubleElimination(logger, model, matchIds, log);
+            while (scheduler.hasWaitingPlayers()) {
+                doubleElimination.addPlayer(scheduler.dequeueWaitingPlayer());
+            }
+            doubleElimination.initializeBracket();
+            doubleElimination.runToCompletion();
+            event.champion = doubleElimination.getTournamentWinner();
         } else {
-            CustomQueue<Player> tempQueue = winnersQueue; 
-            while (!tempQueue.isEmpty()) {
-                cout << tempQueue.dequeue() << endl;
+            for (int round = 1; !scheduler.isTournamentOver(); ++round) {
+                METRICS_ROUND("main_bracket", round);
+                TRACE_SPAN_INDEX("main bracket round", round);
+                if (!scheduler.createNextRoundPairings()) {
+                    break;
+                }
+                scheduler.playAndProcessMatches();
+                if (!scheduler.advanceToNextRound()) {
+                    break;
+                }
             }
+            event.champion = scheduler.getTournamentWinner();
         }
-        cout << "------------------------------------" << endl;
+        event.matchesPlayed = matchIds.peekNext() - 1;
     }
 
-    // Checks if the tournament has concluded
-    bool isTournamentOver() const {
-        return (waitingPlayersQueue.size() == 1 && scheduledMatchesQueue.isEmpty() && winnersQueue.isEmpty());
+public:
+    TournamentHost(int numThreads) : pool(numThreads), wallMs(0.0) {}
+
+    // Queues an event; returns its index for getTournament().
+    int addTournament(const string& name, const DynamicArray<Player>& roster, unsigned long long seed, int bracketFormat) {
+        HostedTournament event;
+        event.name = name;
+        event.roster = roster;
+        event.seed = seed;
+        event.bracketFormat = bracketFormat;
+        events.pushBack(event);
+        return events.size() - 1;
     }
 
-    // Returns the tournament champion if the tournament is over.
-    Player getTournamentWinner() const {
-        if (isTournamentOver()) {
-            return waitingPlayersQueue.peek(); 
-        }
-        if (winnersQueue.size() == 1 && waitingPlayersQueue.isEmpty() && scheduledMatchesQueue.isEmpty()) {
-            return winnersQueue.peek();
+    // Runs every queued event and waits for all of them.
+    void runAll() {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int i = 0; i < events.size(); ++i) {
+            HostedTournament* event = &events[i];
+            pool.submit([event, start]() {
+                chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+                runTournament(*event);
+                chrono::steady_clock::time_point end = chrono::steady_clock::now();
+                event->runMs = elapsedMs(begin, end);
+                event->latencyMs = elapsedMs(start, end);
+            });
         }
-        return Player(); // Returns a default Player (ID "", Name "N/A") if no winner yet or error state
+        pool.waitIdle();
+        wallMs = elapsedMs(start, chrono::steady_clock::now());
     }
-    Player getInitialPlayer(int index) const { // For one-player fallback
-        if (index >= 0 && index < numInitialPlayers) {
-            return initialPlayers[index];
+
+    int getNumTournaments() const { return events.size(); }
+    const HostedTournament& getTournament(int index) const { return events[index]; }
+
+    void printReport(ostream& out) const {
+        out << "\n--- Hosted Tournaments (" << events.size() << " events on " << pool.getNumWorkers() << " worker threads) ---" << endl;
+        long long totalMatches = 0;
+        double totalLatency = 0.0, maxLatency = 0.0;
+        for (int i = 0; i < events.size(); ++i) {
+            const HostedTournament& event = events[i];
+            out << event.name << " | Players: " << event.roster.size() << " | Matches: " << event.matchesPlayed
+                << " | Champion: " << (event.champion.playerId.empty() ? "N/A" : event.champion.playerName)
+                << " | Run: " << event.runMs << " ms | Latency: " << event.latencyMs << " ms" << endl;
+            totalMatches += event.matchesPlayed;
+            totalLatency += event.latencyMs;
+            if (event.latencyMs > maxLatency) {
+                maxLatency = event.latencyMs;
+            }
         }
-        return Player(); 
+        double seconds = wallMs / 1000.0;
+        out << "Wall time: " << wallMs << " ms | Steals: " << pool.getStealCount() << endl;
+        if (seconds > 0.0 && !events.isEmpty()) {
+            out << "Throughput: " << (events.size() / seconds) << " tournaments/s, " << (totalMatches / seconds) << " matches/s" << endl;
+            out << "Latency: mean " << (totalLatency / events.size()) << " ms, max " << maxLatency << " ms" << endl;
+        }
+        out << "------------------------------------" << endl;
     }
 };
 
@@ -924,7 +6399,7 @@ struct QueueNode {
     QueueNode* nextNode;
 
     QueueNode(Player player) : 
-        playerData(player), 
+        playerData(std::move(player)), 
         nextNode(nullptr) {}
 };
 
@@ -968,9 +6443,10 @@ public:
         return queueSize;
     }
 
-    // Add player to the back of queue
+    // Add player to the back of queue (pass with std::move to hand over the strings)
     void enqueue(Player player) {
-        QueueNode* newNode = new QueueNode(player);
+        METRICS_ADD(QueueOperations, 1);
+        QueueNode* newNode = new QueueNode(std::move(player));
 
         if (isEmpty()) {
             frontNode = backNode = newNode;
@@ -987,9 +6463,10 @@ public:
         if (isEmpty()) {
             return Player(); // Return empty player
         }
+        METRICS_ADD(QueueOperations, 1);
 
         QueueNode* removedNode = frontNode;
-        Player removedPlayer = frontNode->playerData;
+        Player removedPlayer = std::move(frontNode->playerData);
 
         frontNode = frontNode->nextNode;
         if (frontNode == nullptr) {
@@ -1003,10 +6480,10 @@ public:
     }
 
     // Peek at front player without removing
-    Player front() {
+    const Player& front() {
         if (isEmpty()) {
             cout << "Registration queue is empty." << endl;
-            return Player();
+            return Player::none();
         }
         return frontNode->playerData;
     }
@@ -1022,8 +6499,7 @@ public:
         // Copy all nodes to a new sorted list
         while (current != nullptr) {
             // Create a copy of the player data to avoid modifying original
-            Player playerCopy = current->playerData; 
-            QueueNode* newNode = new QueueNode(playerCopy);
+            QueueNode* newNode = new QueueNode(current->playerData);
 
             // Insert in sorted order (based on ranking)
             if (sortedHead == nullptr || newNode->playerData.ranking < sortedHead->playerData.ranking) 
@@ -1095,22 +6571,25 @@ public:
     {  
         Player removedPlayer;  // Stores the removed player data
 
-        if (isEmpty()) {
-            return Player(); // Returns empty player if the queue is empty
+        PlayerKey playerKey;
+        if (isEmpty() || !PlayerIdCodec::lookup(playerId, playerKey)) {
+            return Player(); // Returns empty player if the queue is empty (or no player has this ID)
         }
 
         // When the player is at the front
-        if (frontNode->playerData.playerId == playerId) {
-            removedPlayer = dequeue();  // Stores the player data
-            return removedPlayer;  // Returns player data
+        METRICS_ADD(ScanSteps, 1);
+        if (frontNode->playerData.idKey == playerKey) {
+            return dequeue();  // Returns player data
         }
 
         // Search for player in the middle or back of the node
         QueueNode* currentNode = frontNode;
         while (currentNode->nextNode != nullptr) {
-            if (currentNode->nextNode->playerData.playerId == playerId) {
+            METRICS_ADD(ScanSteps, 1);
+            if (currentNode->nextNode->playerData.idKey == playerKey) {
+                METRICS_ADD(QueueOperations, 1);
                 QueueNode* removedNode = currentNode->nextNode;
-                removedPlayer = removedNode->playerData;  // Stores player data
+                removedPlayer = std::move(removedNode->playerData);  // Stores player data
                 currentNode->nextNode = removedNode->nextNode;
 
                 // Update back pointer when removing the last node
@@ -1130,11 +6609,13 @@ public:
 
     // Update player status (when checking in a player)
     bool updatePlayerStatus(string playerId, string newStatus) {
-        QueueNode* currentNode = frontNode;
+        PlayerKey playerKey;
+        QueueNode* currentNode = PlayerIdCodec::lookup(playerId, playerKey) ? frontNode : nullptr;
 
         while (currentNode != nullptr) 
         {
-            if (currentNode->playerData.playerId == playerId) 
+            METRICS_ADD(ScanSteps, 1);
+            if (currentNode->playerData.idKey == playerKey) 
             {
                 string oldStatus = currentNode->playerData.registrationStatus;
                 currentNode->playerData.registrationStatus = newStatus;
@@ -1151,10 +6632,12 @@ public:
 
     void insertByRanking(Player player) 
     {
-        QueueNode* newNode = new QueueNode(player);
+        METRICS_ADD(QueueOperations, 1);
+        int ranking = player.ranking;
+        QueueNode* newNode = new QueueNode(std::move(player));
 
         // If queue is empty or new player has higher ranking (The lower the number, the higher the ranking)
-        if (isEmpty() || player.ranking < frontNode->playerData.ranking) 
+        if (isEmpty() || ranking < frontNode->playerData.ranking) 
         {
             newNode->nextNode = frontNode;
             frontNode = newNode;
@@ -1167,8 +6650,9 @@ public:
             // Find the correct position based on the ranking
             QueueNode* currentNode = frontNode;
             while (currentNode->nextNode != nullptr &&
-                currentNode->nextNode->playerData.ranking < player.ranking) 
+                currentNode->nextNode->playerData.ranking < ranking) 
             {
+                METRICS_ADD(ScanSteps, 1);
                 currentNode = currentNode->nextNode;
             }
 
@@ -1188,13 +6672,21 @@ public:
 // --- PriorityPlayerQueue from provided code (modified to use new Player struct) ---
 class PriorityPlayerQueue {
 private:
+    static const int NUM_PRIORITIES = 4; // getPriority values 0..3
+
     QueueNode* frontNode;
+    QueueNode* tierTails[NUM_PRIORITIES]; // Last queued player of each priority, nullptr if none
     int queueSize;
 
 public:
     PriorityPlayerQueue() : 
         frontNode(nullptr), 
-        queueSize(0) {}
+        queueSize(0) 
+    {
+        for (int i = 0; i < NUM_PRIORITIES; ++i) {
+            tierTails[i] = nullptr;
+        }
+    }
 
     ~PriorityPlayerQueue() 
     {
@@ -1215,27 +6707,30 @@ public:
     }
 
     // Insert player based on priority type (early birds, regular, wildcard)
+    // The player goes behind everyone of the same or higher priority. That is the tail of the
+    // lowest non-empty tier at or above theirs, so no walk is needed (large registrations).
     void enqueue(Player player) 
     {
-        QueueNode* newNode = new QueueNode(player);
+        METRICS_ADD(QueueOperations, 1);
+        int priority = getPriority(player.originalPriority);
+        QueueNode* newNode = new QueueNode(std::move(player));
 
-        // If queue is empty or new player has highest priority
+        QueueNode* previousNode = nullptr;
+        for (int tier = priority; tier < NUM_PRIORITIES && previousNode == nullptr; ++tier) {
+            previousNode = tierTails[tier];
+        }
+
+        // If nobody has the same or higher priority, the new player goes to the front
         // Using originalPriority for determining priority order
-        if (isEmpty() || getPriority(player.originalPriority) > getPriority(frontNode->playerData.originalPriority)) {
+        if (previousNode == nullptr) {
             newNode->nextNode = frontNode;
             frontNode = newNode;
         }
         else {
-            // Find the correct position based on priority
-            QueueNode* currentNode = frontNode;
-            while (currentNode->nextNode != nullptr &&
-                getPriority(currentNode->nextNode->playerData.originalPriority) >= getPriority(player.originalPriority)) {
-                currentNode = currentNode->nextNode;
-            }
-
-            newNode->nextNode = currentNode->nextNode;
-            currentNode->nextNode = newNode;
+            newNode->nextNode = previousNode->nextNode;
+            previousNode->nextNode = newNode;
         }
+        tierTails[priority] = newNode;
 
         queueSize++;
     }
@@ -1245,9 +6740,15 @@ public:
         if (isEmpty()) {
             return Player();
         }
+        METRICS_ADD(QueueOperations, 1);
 
         QueueNode* removedNode = frontNode;
-        Player removedPlayer = frontNode->playerData;
+        for (int tier = 0; tier < NUM_PRIORITIES; ++tier) {
+            if (tierTails[tier] == removedNode) { // Was the only one left in their tier
+                tierTails[tier] = nullptr;
+            }
+        }
+        Player removedPlayer = std::move(frontNode->playerData);
 
         frontNode = frontNode->nextNode;
         delete removedNode;
@@ -1257,7 +6758,7 @@ public:
     }
 
     // Get priority value for comparison (matching CSV strings)
-    int getPriority(string status) 
+    int getPriority(const string& status) 
     {
         if (status == "early birds") return 3;
         if (status == "regular") return 2;
@@ -1357,8 +6858,11 @@ public:
     }
 
     // Load players from file and add to appropriate queues (Modified)
-    void loadPlayersFromFile(string filename) 
+    // Stops after `maxPlayers` players (the championship takes MAX_PLAYERS_UNIVERSAL; load tests
+    // with generated CSVs pass more).
+    void loadPlayersFromFile(string filename, int maxPlayers = MAX_PLAYERS_UNIVERSAL) 
     {
+        TRACE_SPAN("loadPlayersFromFile");
         ifstream file(filename);
         string line;
 
@@ -1371,7 +6875,7 @@ public:
         // Skip header line
         getline(file, line); // "player_id,player_name,ranking,registration type"
 
-        while (getline(file, line) && originalPriorityCount < MAX_PLAYERS_UNIVERSAL) // Limit players loaded
+        while (getline(file, line) && originalPriorityCount < maxPlayers) // Limit players loaded
         {
             stringstream ss(line);
             string playerIdStr, playerNameStr, rankingStr, regTypeStr;
@@ -1390,10 +6894,10 @@ public:
                     int ranking = stoi(rankingStr);
 
                     // Create player directly with CSV status
-                    Player newPlayer(playerIdStr, playerNameStr, ranking, regTypeStr); // registrationStatus is now regTypeStr
+                    Player newPlayer(std::move(playerIdStr), std::move(playerNameStr), ranking, std::move(regTypeStr)); // registrationStatus is now regTypeStr
                                                                                         // originalPriority will also be regTypeStr by constructor
                     
-                    priorityQueue.enqueue(newPlayer);
+                    priorityQueue.enqueue(std::move(newPlayer));
                     originalPriorityCount++; // Count players successfully loaded
                 } catch (const invalid_argument& e) {
                     cerr << "Warning: Invalid number format in line: '" << line << "' - " << e.what() << ". Skipping." << endl;
@@ -1415,6 +6919,7 @@ public:
     // Process priority queue into main registration queue
     void processPriorityRegistrations() 
     {
+        TRACE_SPAN("processPriorityRegistrations");
         cout << "\n--- Processing Priority Registrations ---" << endl;
 
         // Reset counts before processing players into main queue
@@ -1431,7 +6936,7 @@ public:
             else if (player.originalPriority == "wildcard") wildcardCount++;
             else cerr << "Warning: Player " << player.playerName << " has unknown original priority: '" << player.originalPriority << "'." << endl;
 
-            mainRegistrationQueue.enqueue(player);
+            mainRegistrationQueue.enqueue(std::move(player));
         }
 
         cout << "Processed players into main queue:\n"
@@ -1452,11 +6957,11 @@ public:
         Player player = mainRegistrationQueue.dequeue();
 
         player.registrationStatus = "Checked In"; // Update status
-        checkedInQueue.enqueue(player);
 
         cout << "Player " << player.playerName << " (" << player.playerId
             << ") has been checked in successfully. [Original Priority: "
             << player.originalPriority << "]" << endl; // Use player.originalPriority
+        checkedInQueue.enqueue(std::move(player));
     }
 
     // Handle player withdrawal
@@ -1478,8 +6983,8 @@ public:
         // If found and removed from either queue
         if (found) {  
             withdrawnPlayer.registrationStatus = "Withdrawn";  // Update status to "Withdrawn"
-            withdrawnPlayersQueue.enqueue(withdrawnPlayer);    // Enqueue to withdrawn players queue
             cout << "Player " << withdrawnPlayer.playerName << " (" << withdrawnPlayer.playerId << ") has been withdrawn." << endl;
+            withdrawnPlayersQueue.enqueue(std::move(withdrawnPlayer));    // Enqueue to withdrawn players queue
         } else {
             cout << "Player " << playerId << " not found in any active queue for withdrawal." << endl;
         }
@@ -1497,13 +7002,13 @@ public:
         replacementPlayer.originalPriority = determinedOriginalPriority; // Set original priority based on rank
         replacementPlayer.registrationStatus = "Replacement";           // Set current status to Replacement
 
-        mainRegistrationQueue.insertByRanking(replacementPlayer); // Insert into main queue by rank
-        replacementQueue.enqueue(replacementPlayer); // Add to replacement log queue
         replacementCount++; // Increment count of replacement players added
 
         cout << "Replacement player " << replacementPlayer.playerName
             << " (ID: " << replacementPlayer.playerId << ", Rank: " << replacementPlayer.ranking 
             << ", Original Priority: " << replacementPlayer.originalPriority << ") added to registration queue." << endl;
+        replacementQueue.enqueue(replacementPlayer); // Add to replacement log queue
+        mainRegistrationQueue.insertByRanking(std::move(replacementPlayer)); // Insert into main queue by rank
     }
 
     // Adjusts rankings of all players in active queues
@@ -1671,82 +7176,440 @@ void displayRegistrationMenu(TournamentRegistrationSystem& system)
     } while (choice != 6);
 }
 
-int main()
+// Other programs (e.g. Tournament Benchmarks.cpp) include this file for the engine and bring their own main.
+#ifndef TOURNAMENT_NO_MAIN
+int main(int argc, char* argv[])
 {
+    // Registration input:
+    //   --players <path>                         (registration CSV, default updated_player_info.csv)
+    //   --max-players <n>                        (players loaded, and checked in for --host, default 64)
+    // Simulation output options:
+    //   --log-level silent|summary|round|match   (default: match, one line per match)
+    //   --log-file <path>                        (write simulation output to a file instead of stdout)
+    //   --recent-matches <n>                     (results kept for "Display Recent Match Results", default 256)
+    // Crash recovery options:
+    //   --checkpoint <path>                      (save the main bracket at every round boundary)
+    //   --resume <path>                          (skip Phases 1-3 and continue from a checkpoint)
+    // Persistent match history:
+    //   --history-file <path>                    (append every recorded match to a binary history file)
+    //   --history-sync <n>                       (records per durable batch, default 64)
+    //   --read-history <path>                    (map a history file, possibly still being written, and report on it)
+    //   --player <id>                            (with --read-history: that player's record and matches)
+    // Seeding from ratings:
+    //   --season-history <path>                  (rate last season's history files, repeatable, and seed by rating)
+    //   --rating-period <n>                      (matches per Glicko rating period, default 10000)
+    //   --rating-threads <n>                     (threads for the season recompute, default: all cores)
+    // Multi-tournament hosting:
+    //   --host <count>                           (run <count> regional events on the checked-in roster)
+    //   --host-threads <n>                       (worker threads for --host, default: all cores)
+    //   --host-bracket single|double             (main bracket format for --host, default: single)
+    // Instrumentation (builds with -DTOURNAMENT_METRICS):
+    //   --metrics <path>                         (write phase/round timings and counters when the run ends)
+    //   --metrics-format json|prometheus         (report format, default: json)
+    // Timeline (builds with -DTOURNAMENT_TRACE):
+    //   --trace <path>                           (Chrome trace written when the run ends, default tournament_trace.json)
+    SimulationLog simulationLog;
+    string playersPath = "updated_player_info.csv";
+    int maxPlayers = MAX_PLAYERS_UNIVERSAL;
+    string checkpointPath;
+    string resumePath;
+    int hostedEvents = 0;
+    int hostThreads = static_cast<int>(thread::hardware_concurrency());
+    int hostBracketFormat = 1;
+    int recentMatchesCapacity = GameResultLogger::DEFAULT_RECENT_MATCHES;
+    string historyPath;
+    int historySyncEvery = MatchHistoryFile::DEFAULT_SYNC_EVERY;
+    string readHistoryPath;
+    string readHistoryPlayer;
+    DynamicArray<string> seasonHistoryPaths;
+    int ratingPeriodMatches = GlickoSeasonRater::DEFAULT_PERIOD_MATCHES;
+    int ratingThreads = static_cast<int>(thread::hardware_concurrency());
+    string metricsPath;
+    bool metricsPrometheus = false;
+    string tracePath;
+    for (int i = 1; i < argc; ++i) {
+        string option = argv[i];
+        if (option == "--players" && i + 1 < argc) {
+            playersPath = argv[++i];
+        } else if (option == "--max-players" && i + 1 < argc) {
+            maxPlayers = atoi(argv[++i]);
+            if (maxPlayers < 1) {
+                cerr << "Warning: --max-players must be positive. Using " << MAX_PLAYERS_UNIVERSAL << "." << endl;
+                maxPlayers = MAX_PLAYERS_UNIVERSAL;
+            }
+        } else if (option == "--log-level" && i + 1 < argc) {
+            string level = argv[++i];
+            if (level == "silent") simulationLog.setVerbosity(LogVerbosity::Silent);
+            else if (level == "summary") simulationLog.setVerbosity(LogVerbosity::Summary);
+            else if (level == "round") simulationLog.setVerbosity(LogVerbosity::PerRound);
+            else if (level == "match") simulationLog.setVerbosity(LogVerbosity::PerMatch);
+            else cerr << "Warning: Unknown log level '" << level << "'. Using 'match'." << endl;
+        } else if (option == "--log-file" && i + 1 < argc) {
+            simulationLog.openFile(argv[++i]);
+        } else if (option == "--recent-matches" && i + 1 < argc) {
+            recentMatchesCapacity = atoi(argv[++i]);
+            if (recentMatchesCapacity < 1) {
+                cerr << "Warning: --recent-matches must be positive. Using " << GameResultLogger::DEFAULT_RECENT_MATCHES << "." << endl;
+                recentMatchesCapacity = GameResultLogger::DEFAULT_RECENT_MATCHES;
+            }
+        } else if (option == "--history-file" && i + 1 < argc) {
+            historyPath = argv[++i];
+        } else if (option == "--history-sync" && i + 1 < argc) {
+            historySyncEvery = atoi(argv[++i]);
+            if (historySyncEvery < 1) {
+                cerr << "Warning: --history-sync must be positive. Using " << MatchHistoryFile::DEFAULT_SYNC_EVERY << "." << endl;
+                historySyncEvery = MatchHistoryFile::DEFAULT_SYNC_EVERY;
+            }
+        } else if (option == "--read-history" && i + 1 < argc) {
+            readHistoryPath = argv[++i];
+        } else if (option == "--player" && i + 1 < argc) {
+            readHistoryPlayer = argv[++i];
+        } else if (option == "--season-history" && i + 1 < argc) {
+            seasonHistoryPaths.pushBack(argv[++i]);
+        } else if (option == "--rating-period" && i + 1 < argc) {
+            ratingPeriodMatches = atoi(argv[++i]);
+            if (ratingPeriodMatches < 1) {
+                cerr << "Warning: --rating-period must be positive. Using " << GlickoSeasonRater::DEFAULT_PERIOD_MATCHES << "." << endl;
+                ratingPeriodMatches = GlickoSeasonRater::DEFAULT_PERIOD_MATCHES;
+            }
+        } else if (option == "--rating-threads" && i + 1 < argc) {
+            ratingThreads = atoi(argv[++i]);
+        } else if (option == "--checkpoint" && i + 1 < argc) {
+            checkpointPath = argv[++i];
+        } else if (option == "--resume" && i + 1 < argc) {
+            resumePath = argv[++i];
+        } else if (option == "--host" && i + 1 < argc) {
+            hostedEvents = atoi(argv[++i]);
+        } else if (option == "--host-threads" && i + 1 < argc) {
+            hostThreads = atoi(argv[++i]);
+        } else if (option == "--host-bracket" && i + 1 < argc) {
+            string format = argv[++i];
+            if (format == "single") hostBracketFormat = 1;
+            else if (format == "double") hostBracketFormat = 2;
+            else cerr << "Warning: Unknown host bracket '" << format << "'. Using 'single'." << endl;
+        } else if (option == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (option == "--metrics" && i + 1 < argc) {
+            metricsPath = argv[++i];
+        } else if (option == "--metrics-format" && i + 1 < argc) {
+            string format = argv[++i];
+            if (format == "json") metricsPrometheus = false;
+            else if (format == "prometheus") metricsPrometheus = true;
+            else cerr << "Warning: Unknown metrics format '" << format << "'. Using 'json'." << endl;
+        } else {
+            cerr << "Warning: Ignoring unknown option '" << option << "'." << endl;
+        }
+    }
+#ifdef TOURNAMENT_METRICS
+    TournamentMetrics::ReportAtExit metricsReport(metricsPath, metricsPrometheus); // Written however main returns
+#else
+    if (!metricsPath.empty()) {
+        cerr << "Warning: Built without TOURNAMENT_METRICS. No metrics report will be written." << endl;
+    }
+    (void)metricsPrometheus;
+#endif
+#ifdef TOURNAMENT_TRACE
+    TournamentTrace::WriteAtExit traceWriter(tracePath.empty() ? "tournament_trace.json" : tracePath);
+#else
+    if (!tracePath.empty()) {
+        cerr << "Warning: Built without TOURNAMENT_TRACE. No trace will be written." << endl;
+    }
+#endif
+
     cout << "--- ASIA PACIFIC UNIVERSITY ESPORTS CHAMPIONSHIP ---" << endl;
     cout << "Tournament Registration & Player Queue Management System" << endl;
     cout << string(60, '-') << endl;
 
-    // Seed random number generator ONCE at the start of the program
-    srand(static_cast<unsigned int>(time(0)));
-
-    GameResultLogger gameLogger;          // Create Task 4 logger instance
-    MatchScheduler scheduler(gameLogger); // Pass logger to Task 1 scheduler
-
-    TournamentRegistrationSystem regSystem; // Instantiate the registration system
-
-    // --- Phase 1: Registration ---
-    cout << "\n===== PHASE 1: PLAYER REGISTRATION =====" << endl;
-    regSystem.loadPlayersFromFile("updated_player_info.csv"); 
-    regSystem.processPriorityRegistrations(); 
-    displayRegistrationMenu(regSystem); // User interacts with registration system
-
-    // --- Phase 2: Transition from Registration to Tournament ---
-    cout << "\n===== PHASE 2: TOURNAMENT SETUP =====" << endl;
+    if (!readHistoryPath.empty()) {
+        // Analytics mode: queries run directly on the mapped file, nothing is simulated
+        METRICS_PHASE("read_history");
+        MatchHistoryFileReader history;
+        if (!history.open(readHistoryPath)) {
+            return 1;
+        }
+        long long corrections = 0;
+        for (long long i = 0; i < history.getNumRecords(); ++i) {
+            if (history.getRecord(i).recordType != static_cast<unsigned char>(MatchRecordType::Result)) {
+                corrections++;
+            }
+        }
+        cout << "\n--- Match History File: " << readHistoryPath << " ---" << endl;
+        cout << "Committed records: " << history.getNumRecords() << " (" << corrections << " corrections)" << endl;
+        if (history.getNumRecords() > 0) {
+            cout << "First: " << history.getRecord(0).toHistoricalMatch() << endl;
+            cout << "Last:  " << history.getRecord(history.getNumRecords() - 1).toHistoricalMatch() << endl;
+        }
+        if (!readHistoryPlayer.empty()) {
+            int wins, losses;
+            long long involved = history.tallyPlayer(readHistoryPlayer, wins, losses);
+            cout << "\nPlayer " << readHistoryPlayer << ": " << wins << " wins, " << losses << " losses ("
+                 << involved << " records)" << endl;
+            history.printPlayerMatches(cout, readHistoryPlayer);
+        }
+        cout << "--------------------------------------------------------------------" << endl;
+        return 0;
+    }
 
-    PlayerQueue* checkedInPlayersQueue = regSystem.getCheckedInPlayersQueue();
-    if (checkedInPlayersQueue->isEmpty()) {
-        cout << "No players checked in for the tournament. Cannot proceed with tournament simulation. Exiting." << endl;
+    // Seed the match outcome generator ONCE at the start of the program
+    MatchOutcomeModel outcomeModel(static_cast<unsigned long long>(time(0)));
+
+    if (hostedEvents > 0) {
+        // Register once, then run every regional event on the same roster with its own seed
+        METRICS_PHASE("registration");
+        TournamentRegistrationSystem regSystem;
+        regSystem.loadPlayersFromFile(playersPath, maxPlayers);
+        regSystem.processPriorityRegistrations();
+        regSystem.batchCheckIn(maxPlayers);
+        DynamicArray<Player> roster;
+        PlayerQueue* checkedInPlayersQueue = regSystem.getCheckedInPlayersQueue();
+        while (!checkedInPlayersQueue->isEmpty()) {
+            roster.pushBack(checkedInPlayersQueue->dequeue());
+        }
+        if (roster.isEmpty()) {
+            cout << "No players checked in for the hosted events. Exiting." << endl;
+            return 0;
+        }
+        METRICS_PHASE("hosted_events");
+        TournamentHost host(hostThreads > 0 ? hostThreads : 1);
+        for (int i = 0; i < hostedEvents; ++i) {
+            host.addTournament("Regional " + to_string(i + 1), roster, outcomeModel.nextSeed(), hostBracketFormat);
+        }
+        host.runAll();
+        host.printReport(cout);
         return 0;
     }
 
-    // Transfer checked-in players to the MatchScheduler
+    GameResultLogger gameLogger(recentMatchesCapacity); // Create Task 4 logger instance
+    MatchIdSequence matchIds;                           // Match numbering for this tournament
+    MatchScheduler scheduler(gameLogger, outcomeModel, matchIds, simulationLog); // Pass logger to Task 1 scheduler
+    if (!checkpointPath.empty() || !resumePath.empty()) {
+        gameLogger.setJournalEnabled(true); // Checkpoints write only the matches logged since the previous one
+    }
+
     int numPlayersAddedToScheduler = 0;
-    while (!checkedInPlayersQueue->isEmpty()) {
-        Player p = checkedInPlayersQueue->dequeue();
-        scheduler.addPlayer(p); // This also initializes player stats in GameResultLogger
-        numPlayersAddedToScheduler++;
+    int bracketFormat = 1;
+    int roundNum = 1;
+    bool resumed = false;
+    if (!resumePath.empty()) {
+        CheckpointRoundInfo resumeInfo;
+        if (!TournamentCheckpoint::load(resumePath, scheduler, gameLogger, outcomeModel, resumeInfo)) {
+            cout << "Unable to resume from checkpoint " << resumePath << ". Exiting." << endl;
+            return 1;
+        }
+        resumed = true;
+        numPlayersAddedToScheduler = resumeInfo.numPlayersInEvent;
+        bracketFormat = resumeInfo.bracketFormat;
+        roundNum = resumeInfo.roundNumber;
+        if (checkpointPath.empty()) {
+            checkpointPath = resumePath;
+        }
+        cout << "\nResumed from checkpoint " << resumePath << " at main bracket round " << roundNum << "." << endl;
     }
 
-    if (numPlayersAddedToScheduler == 0) {
-        cout << "No players were transferred to the tournament scheduler. Exiting." << endl;
-        return 0;
+    MatchHistoryFile historyFile(historySyncEvery);
+    if (!historyPath.empty()) {
+        // A resumed event continues its file from the checkpoint's last logged match
+        bool opened = resumed ? historyFile.reopen(historyPath, gameLogger.getNumLoggedMatches())
+                              : historyFile.create(historyPath);
+        if (opened) {
+            gameLogger.setHistoryFile(&historyFile);
+        } else {
+            cerr << "Warning: Running without a match history file." << endl;
+        }
     }
 
-    cout << "Successfully transferred " << numPlayersAddedToScheduler << " checked-in players to the tournament system." << endl;
+    if (!resumed) {
+        TournamentRegistrationSystem regSystem; // Instantiate the registration system
+
+        // --- Phase 1: Registration ---
+        cout << "\n===== PHASE 1: PLAYER REGISTRATION =====" << endl;
+        METRICS_PHASE("registration");
+        regSystem.loadPlayersFromFile(playersPath, maxPlayers); 
+        regSystem.processPriorityRegistrations(); 
+        displayRegistrationMenu(regSystem); // User interacts with registration system
+
+        // --- Phase 2: Transition from Registration to Tournament ---
+        cout << "\n===== PHASE 2: TOURNAMENT SETUP =====" << endl;
+        METRICS_PHASE("setup");
+
+        PlayerQueue* checkedInPlayersQueue = regSystem.getCheckedInPlayersQueue();
+        if (checkedInPlayersQueue->isEmpty()) {
+            cout << "No players checked in for the tournament. Cannot proceed with tournament simulation. Exiting." << endl;
+            return 0;
+        }
+
+        // Transfer checked-in players to the MatchScheduler
+        while (!checkedInPlayersQueue->isEmpty()) {
+            scheduler.addPlayer(checkedInPlayersQueue->dequeue()); // Moves the player in; also initializes player stats in GameResultLogger
+            numPlayersAddedToScheduler++;
+        }
+
+        if (numPlayersAddedToScheduler == 0) {
+            cout << "No players were transferred to the tournament scheduler. Exiting." << endl;
+            return 0;
+        }
+
+        cout << "Successfully transferred " << numPlayersAddedToScheduler << " checked-in players to the tournament system." << endl;
+
+        if (!seasonHistoryPaths.isEmpty()) {
+            // Rate last season's matches and start every returning player from their season rating
+            chrono::steady_clock::time_point ratingStart = chrono::steady_clock::now();
+            GlickoSeasonRater season(ratingPeriodMatches);
+            for (int i = 0; i < seasonHistoryPaths.size(); ++i) {
+                if (!season.loadHistoryFile(seasonHistoryPaths[i])) {
+                    cerr << "Warning: Skipping season history file " << seasonHistoryPaths[i] << "." << endl;
+                }
+            }
+            season.recompute(ratingThreads > 0 ? ratingThreads : 1);
+            int ratedPlayers = season.applyTo(gameLogger);
+            scheduler.setSeedByRating(ratedPlayers > 0);
+            double ratingMs = chrono::duration<double, milli>(chrono::steady_clock::now() - ratingStart).count();
+            cout << "Season ratings: " << season.getNumMatches() << " matches (" << season.getNumCorrections()
+                 << " corrections) in " << season.getNumPeriods() << " rating periods, " << ratedPlayers << " of "
+                 << numPlayersAddedToScheduler << " players rated (" << ratingMs << " ms)." << endl;
+        }
     
-    // Initialize tournament with all successfully added players (sorts them by rank)
-    scheduler.initializeTournament(); 
-
-    if (numPlayersAddedToScheduler == 1) {
-        cout << "\nOnly one player checked in. This player is the champion by default." << endl;
-    } else {
-        // --- Phase 3: Group Stage Execution ---
-        cout << "\n===== PHASE 3: GROUP STAGE =====" << endl;
-        int numGroups = 16; 
-        scheduler.runGroupStage(numGroups);
+        // Initialize tournament with all successfully added players (sorts them by rank)
+        scheduler.initializeTournament(); 
+        simulationLog.flush();
+
+        if (numPlayersAddedToScheduler == 1) {
+            cout << "\nOnly one player checked in. This player is the champion by default." << endl;
+        } else {
+            // --- Phase 3: Group Stage Execution ---
+            cout << "\n===== PHASE 3: GROUP STAGE =====" << endl;
+            METRICS_PHASE("group_stage");
+            cout << "\nSelect group stage format:" << endl;
+            cout << "1. Standard (16 groups of 4, by registration type)" << endl;
+            cout << "2. League round robin (custom group size)" << endl;
+            cout << "Enter your choice (1-2): ";
+            int groupFormat;
+            while (!(cin >> groupFormat) || groupFormat < 1 || groupFormat > 2) {
+                cout << "Invalid choice. Please enter 1 or 2: ";
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            }
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+
+            if (groupFormat == 1) {
+                int numGroups = 16; 
+                scheduler.runGroupStage(numGroups);
+            } else {
+                int groupSize, cycles, advancePerGroup;
+                cout << "Enter players per group: ";
+                while (!(cin >> groupSize) || groupSize < 2) {
+                    cout << "Invalid input. Please enter an integer of at least 2: ";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                }
+                cout << "Single (1) or double (2) round robin? ";
+                while (!(cin >> cycles) || cycles < 1 || cycles > 2) {
+                    cout << "Invalid input. Please enter 1 or 2: ";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                }
+                cout << "Enter number of players advancing from each group: ";
+                while (!(cin >> advancePerGroup) || advancePerGroup < 1) {
+                    cout << "Invalid input. Please enter a positive integer: ";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                }
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                int numThreads = static_cast<int>(thread::hardware_concurrency());
+                scheduler.runLeagueGroupStage(groupSize, cycles == 2, advancePerGroup, numThreads > 0 ? numThreads : 1);
+            }
         
-        // After group stage, winners are in winnersQueue, they need to be advanced to waitingPlayersQueue
-        // to start the main bracket loop. This ensures exactly 32 players enter the main bracket.
-        cout << "\n--- Advancing Group Stage Winners to Main Bracket Pool ---" << endl;
-        scheduler.advanceToNextRound(); 
+            // After group stage, winners are in winnersQueue, they need to be advanced to waitingPlayersQueue
+            // to start the main bracket loop (32 players with the standard format).
+            simulationLog.at(LogVerbosity::PerRound) << "\n--- Advancing Group Stage Winners to Main Bracket Pool ---\n";
+            scheduler.advanceToNextRound(); 
+            simulationLog.flush();
+        }
+
+        // Choose the main bracket format
+        if (numPlayersAddedToScheduler > 1) {
+            cout << "\nSelect main bracket format:" << endl;
+            cout << "1. Single Elimination" << endl;
+            cout << "2. Double Elimination (winners & losers brackets, grand final with reset)" << endl;
+            cout << "3. Single Elimination, pipelined (matches resolved on worker threads)" << endl;
+            cout << "4. Single Elimination, event-driven (matches finish in any order)" << endl;
+            cout << "Enter your choice (1-4): ";
+            while (!(cin >> bracketFormat) || bracketFormat < 1 || bracketFormat > 4) {
+                cout << "Invalid choice. Please enter 1, 2, 3 or 4: ";
+                cin.clear();
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            }
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
     }
 
     // --- Phase 4: Tournament Simulation (Main Bracket) ---
-    cout << "\n===== PHASE 4: TOURNAMENT SIMULATION (MAIN BRACKET) BEGINS =====" << endl;
-    int roundNum = 1;
-    while (true) {
+    simulationLog.at(LogVerbosity::Summary) << "\n===== PHASE 4: TOURNAMENT SIMULATION (MAIN BRACKET) BEGINS =====\n";
+    METRICS_PHASE("main_bracket");
+    Player separateBracketChampion; // Champion of the formats that run outside MatchScheduler (2 and 4)
+    if (bracketFormat == 4) {
+        EventDrivenBracket eventBracket(gameLogger, outcomeModel, matchIds, simulationLog);
+        while (scheduler.hasWaitingPlayers()) {
+            eventBracket.addPlayer(scheduler.dequeueWaitingPlayer());
+        }
+        eventBracket.initializeBracket();
+        eventBracket.runToCompletion();
+        separateBracketChampion = eventBracket.getTournamentWinner();
+        simulationLog.at(LogVerbosity::Summary) << "Event-driven bracket finished after " << eventBracket.getMatchesReported() << " matches.\n";
+    }
+    if (bracketFormat == 2) {
+        DoubleEliminationScheduler doubleElimination(gameLogger, outcomeModel, matchIds, simulationLog);
+        while (scheduler.hasWaitingPlayers()) {
+            doubleElimination.addPlayer(scheduler.dequeueWaitingPlayer());
+        }
+        doubleElimination.initializeBracket();
+        doubleElimination.runToCompletion();
+        separateBracketChampion = doubleElimination.getTournamentWinner();
+        simulationLog.at(LogVerbosity::Summary) << "Double-elimination bracket finished after " << doubleElimination.getMatchesPlayed() << " matches.\n";
+    }
+    TournamentCheckpoint checkpoint(checkpointPath);
+    bool checkpointing = !checkpointPath.empty();
+    if (checkpointing && (bracketFormat == 2 || bracketFormat == 4)) {
+        cerr << "Warning: Checkpoints cover the single-elimination bracket only. Running without them." << endl;
+        checkpointing = false;
+    }
+    int maxMainBracketRounds = 0; // ceil(log2(players)): enough rounds for any field size
+    for (int fieldSize = 1; fieldSize < numPlayersAddedToScheduler; fieldSize *= 2) {
+        maxMainBracketRounds++;
+    }
+    int pipelineWorkers = static_cast<int>(thread::hardware_concurrency());
+    if (pipelineWorkers < 1) {
+        pipelineWorkers = 1;
+    }
+    while (bracketFormat == 1 || bracketFormat == 3) {
         if (scheduler.isTournamentOver()) {
             break; // Tournament ends if only one player is left
         }
-        cout << "\n<<<<< ROUND " << roundNum << " (Main Bracket) >>>>>" << endl;
+        METRICS_ROUND("main_bracket", roundNum);
+        TRACE_SPAN_INDEX("main bracket round", roundNum);
+        if (checkpointing) { // Round boundary: everything needed to replay from here
+            historyFile.flush(); // The history file never lags behind the checkpoint
+            CheckpointRoundInfo roundInfo = {roundNum, bracketFormat, numPlayersAddedToScheduler};
+            if (!checkpoint.saveRound(scheduler, gameLogger, outcomeModel, roundInfo)) {
+                cerr << "Warning: Checkpoint for round " << roundNum << " could not be written." << endl;
+            }
+        }
+        simulationLog.at(LogVerbosity::PerRound) << "\n<<<<< ROUND " << roundNum << " (Main Bracket) >>>>>\n";
 
-        if (!scheduler.createNextRoundPairings()) {
-            if (scheduler.isTournamentOver()) break; 
-            cout << "No more matches can be scheduled in the main bracket. Tournament might have ended prematurely or unevenly." << endl;
-            break; 
+        if (bracketFormat == 3) {
+            if (!scheduler.runPipelinedRound(pipelineWorkers)) {
+                if (scheduler.isTournamentOver()) break;
+                cout << "No more matches can be scheduled in the main bracket. Tournament might have ended prematurely or unevenly." << endl;
+                break;
+            }
+        } else {
+            if (!scheduler.createNextRoundPairings()) {
+                if (scheduler.isTournamentOver()) break; 
+                cout << "No more matches can be scheduled in the main bracket. Tournament might have ended prematurely or unevenly." << endl;
+                break; 
+            }
+            scheduler.playAndProcessMatches();   // Simulate matches, update winners
         }
-        scheduler.playAndProcessMatches();   // Simulate matches, update winners
 
         if (!scheduler.advanceToNextRound()) {
             if (scheduler.isTournamentOver()) break; 
@@ -1755,14 +7618,18 @@ int main()
         }
         roundNum++;
         
-        if (roundNum > 6 && numPlayersAddedToScheduler > 1) { 
+        if (roundNum > maxMainBracketRounds && numPlayersAddedToScheduler > 1) { 
             cout << "Warning: Tournament simulation is taking unusually long. Halting to prevent infinite loop." << endl;
             break;
         }
     }
 
+    simulationLog.flush(); // Phase boundary: the bracket output goes out before the results
     cout << "\n===== TOURNAMENT SIMULATION COMPLETE =====" << endl;
-    Player champion = scheduler.getTournamentWinner();
+    if (historyFile.isOpen() && historyFile.flush()) {
+        cout << "Match history: " << historyFile.getCommittedRecords() << " records saved to " << historyFile.getPath() << endl;
+    }
+    const Player& champion = (bracketFormat == 2 || bracketFormat == 4) ? separateBracketChampion : scheduler.getTournamentWinner();
     if (champion.playerId != "" && champion.playerName != "N/A") { 
         cout << "Champion: " << champion.playerName << " (ID: " << champion.playerId << ", Rank: " << champion.ranking << ")" << endl;
     } else if (numPlayersAddedToScheduler == 1) {
@@ -1779,6 +7646,8 @@ int main()
 
     // --- Phase 5: Post-Tournament Reports ---
     cout << "\n===== PHASE 5: POST-TOURNAMENT REPORTS =====" << endl;
+    METRICS_PHASE("reports");
+    MatchQueryEngine matchQueries(gameLogger.getMatchLog()); // Indexes the log on the first query
     char reportChoice;
     do {
         cout << "\nGame Result Logging & Performance History Options:" << endl;
@@ -1786,6 +7655,11 @@ int main()
         cout << "2. Display All Logged Matches (Chronological)" << endl;
         cout << "3. Display All Player Performances Summary" << endl;
         cout << "4. Display Specific Player's Full Performance Record" << endl;
+        cout << "5. Head-to-Head Record of Two Players" << endl;
+        cout << "6. Matches in a Round or Group" << endl;
+        cout << "7. Upsets (Lower-Ranked Player Won)" << endl;
+        cout << "8. Tier vs Tier Win Rates" << endl;
+        cout << "9. Leaderboard (Top Players)" << endl;
         cout << "X. Exit Reports Menu" << endl;
         cout << "Enter your choice: ";
         cin >> reportChoice;
@@ -1817,6 +7691,72 @@ int main()
                 gameLogger.displaySinglePlayerPerformance(playerIdToView);
                 break;
             }
+            case '5': {
+                string firstId, secondId;
+                cout << "Enter the first Player ID (e.g., PL001): ";
+                getline(cin, firstId);
+                cout << "Enter the second Player ID (e.g., PL002): ";
+                getline(cin, secondId);
+                matchQueries.displayHeadToHead(firstId, secondId);
+                break;
+            }
+            case '6': {
+                int scope, number;
+                cout << "1. Main bracket round, 2. Group-stage round, 3. Group: ";
+                while (!(cin >> scope) || scope < 1 || scope > 3) {
+                    cout << "Invalid choice. Please enter 1, 2 or 3: ";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                }
+                cout << (scope == 3 ? "Enter group number: " : "Enter round number: ");
+                while (!(cin >> number) || number <= 0) {
+                    cout << "Invalid input. Please enter a positive integer: ";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                }
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                if (scope == 3) {
+                    matchQueries.displayGroupMatches(number);
+                } else {
+                    matchQueries.displayRoundMatches(number, scope == 2);
+                }
+                break;
+            }
+            case '7':
+                matchQueries.displayUpsets();
+                break;
+            case '8': {
+                int tierWidth;
+                cout << "Ranks per tier (e.g., 16 for ranks 1-16, 17-32, ...): ";
+                while (!(cin >> tierWidth) || tierWidth <= 0) {
+                    cout << "Invalid input. Please enter a positive integer: ";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                }
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                matchQueries.displayTierWinRates(tierWidth);
+                break;
+            }
+            case '9': {
+                int orderChoice, count;
+                cout << "Rank by 1. Wins, 2. Win rate or 3. Rating: ";
+                while (!(cin >> orderChoice) || orderChoice < 1 || orderChoice > 3) {
+                    cout << "Invalid choice. Please enter 1, 2 or 3: ";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                }
+                cout << "How many players to show? (e.g., 10): ";
+                while (!(cin >> count) || count <= 0) {
+                    cout << "Invalid input. Please enter a positive integer: ";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                }
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                LeaderboardOrder order = (orderChoice == 2) ? LeaderboardOrder::WinRate
+                                       : (orderChoice == 3) ? LeaderboardOrder::Rating : LeaderboardOrder::Wins;
+                gameLogger.displayLeaderboard(count, order);
+                break;
+            }
             case 'X':
                 cout << "Exiting reports menu." << endl;
                 break;
@@ -1827,4 +7767,5 @@ int main()
 
     cout << "\nExiting Esports Championship Management System. Goodbye!" << endl;
     return 0;
-}
\ No newline at end of file
+}
+#endif // TOURNAMENT_NO_MAIN
@@ -0,0 +1,1819 @@
+// Benchmarks for the tournament engine in "Task 1 Simulation.cpp".
+// Build: g++ -std=c++17 -O2 -pthread "Tournament Benchmarks.cpp" -o "Tournament Benchmarks"
+// Run all benchmarks, or name the ones to run: "Tournament Benchmarks" event-bracket
+// The engine suite writes JSON: "Tournament Benchmarks" suite --json results.json
+#define TOURNAMENT_NO_MAIN
+#include "Task 1 Simulation.cpp"
+
+#include <algorithm> // std::sort for the full-sort baseline
+#include <chrono>
+#include <iomanip>
+#include <new>
+
+// --- Heap accounting ---
+// Replacement global operator new/delete that track live heap bytes and the number of
+// allocations, so a benchmark can report what a data structure really holds.
+atomic<long long> liveHeapBytes(0);
+atomic<long long> heapAllocations(0);
+const size_t HEAP_HEADER = 16; // Keeps the returned block 16-byte aligned
+
+void* operator new(size_t size) {
+    void* block = malloc(size + HEAP_HEADER);
+    if (block == nullptr) {
+        throw bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    liveHeapBytes += static_cast<long long>(size);
+    heapAllocations++;
+    return static_cast<char*>(block) + HEAP_HEADER;
+}
+
+void operator delete(void* pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    char* block = static_cast<char*>(pointer) - HEAP_HEADER;
+    liveHeapBytes -= static_cast<long long>(*reinterpret_cast<size_t*>(block));
+    free(block);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+    operator delete(pointer);
+}
+
+// --- Helpers ---
+typedef chrono::steady_clock BenchClock;
+
+double millisecondsSince(BenchClock::time_point start) {
+    return chrono::duration<double, milli>(BenchClock::now() - start).count();
+}
+
+// Synthetic entrants ranked 1..count (already in seeding order, so sorting them is linear).
+void makeSyntheticPlayers(int count, DynamicArray<Player>& out) {
+    out.clear();
+    out.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Player player;
+        player.setId("BP" + to_string(i + 1));
+        player.playerName = "Bench Player " + to_string(i + 1);
+        player.ranking = i + 1;
+        player.originalPriority = "regular";
+        out.pushBack(player);
+    }
+}
+
+// splitmix64: stateless pseudo-random value for a key
+unsigned long long mixKey(unsigned long long key) {
+    unsigned long long z = key + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Binary min-heap of (finish time, bracket node) for the simulated clock.
+class FinishHeap {
+private:
+    DynamicArray<double> times;
+    DynamicArray<int> nodes;
+
+    void swapEntries(int a, int b) {
+        std::swap(times[a], times[b]);
+        std::swap(nodes[a], nodes[b]);
+    }
+
+public:
+    bool isEmpty() const { return times.isEmpty(); }
+
+    void push(double time, int node) {
+        times.pushBack(time);
+        nodes.pushBack(node);
+        int i = times.size() - 1;
+        while (i > 0 && times[(i - 1) / 2] > times[i]) {
+            swapEntries(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    // Removes and returns the earliest entry.
+    void pop(double& time, int& node) {
+        time = times[0];
+        node = nodes[0];
+        swapEntries(0, times.size() - 1);
+        times.popBack();
+        nodes.popBack();
+        int i = 0;
+        while (true) {
+            int smallest = i;
+            int left = 2 * i + 1, right = 2 * i + 2;
+            if (left < times.size() && times[left] < times[smallest]) smallest = left;
+            if (right < times.size() && times[right] < times[smallest]) smallest = right;
+            if (smallest == i) break;
+            swapEntries(i, smallest);
+            i = smallest;
+        }
+    }
+};
+
+// --- Event-driven bracket ---
+// (a) Results arrive in a uniformly random order: cost of reporting a result and releasing
+//     whatever it unblocks.
+// (b) Simulated clock: every match takes 20-60 minutes and any number of matches can run at
+//     once. The event-driven bracket starts each match when its feeders finish; the lockstep
+//     scheduler waits for the whole round. Reports the bracket duration of both and how long
+//     a ready pairing waits in lockstep mode.
+void benchmarkEventDrivenBracket() {
+    cout << "\n=== Event-driven bracket: release on out-of-order results ===" << endl;
+    cout << setw(10) << "players" << setw(14) << "results" << setw(12) << "ns/result" << setw(12) << "peak ready"
+         << setw(16) << "event (min)" << setw(16) << "lockstep (min)" << setw(18) << "lockstep wait" << endl;
+
+    const int sizes[] = {64, 4096, 65536, 1048576};
+    for (int sizeIndex = 0; sizeIndex < 4; ++sizeIndex) {
+        int numPlayers = sizes[sizeIndex];
+        DynamicArray<Player> entrants;
+        makeSyntheticPlayers(numPlayers, entrants);
+
+        GameResultLogger logger;
+        MatchOutcomeModel model(12345);
+        MatchIdSequence matchIds;
+        SimulationLog log(LogVerbosity::Silent, 4096);
+
+        // (a) Random completion order
+        EventDrivenBracket randomOrder(logger, model, matchIds, log);
+        randomOrder.setResultLogging(false);
+        randomOrder.reservePlayers(numPlayers);
+        for (int i = 0; i < numPlayers; ++i) {
+            randomOrder.addPlayer(entrants[i]);
+        }
+        randomOrder.initializeBracket();
+        MatchOutcomeModel picker(numPlayers);
+        int peakReady = randomOrder.getNumReadyMatches();
+        BenchClock::time_point start = BenchClock::now();
+        while (randomOrder.getNumReadyMatches() > 0) {
+            int pick = static_cast<int>(picker.nextSeed() % static_cast<unsigned long long>(randomOrder.getNumReadyMatches()));
+            randomOrder.reportResult(randomOrder.getReadyMatch(pick), picker.player1Wins());
+            if (randomOrder.getNumReadyMatches() > peakReady) {
+                peakReady = randomOrder.getNumReadyMatches();
+            }
+        }
+        double elapsedMs = millisecondsSince(start);
+        int results = randomOrder.getMatchesReported();
+
+        // (b) Simulated clock, completion order given by match durations
+        EventDrivenBracket timed(logger, model, matchIds, log);
+        timed.setResultLogging(false);
+        timed.reservePlayers(numPlayers);
+        for (int i = 0; i < numPlayers; ++i) {
+            timed.addPlayer(entrants[i]);
+        }
+        timed.initializeBracket();
+        int bracketSize = timed.getBracketSize();
+        DynamicArray<double> duration; // Per bracket node, minutes
+        duration.reserve(bracketSize);
+        for (int node = 0; node < bracketSize; ++node) {
+            duration.pushBack(20.0 + static_cast<double>(mixKey(static_cast<unsigned long long>(node)) % 41ULL));
+        }
+        FinishHeap running;
+        for (int k = 0; k < timed.getNumReadyMatches(); ++k) {
+            int node = timed.getReadyMatch(k);
+            running.push(duration[node], node);
+        }
+        double eventMakespan = 0.0;
+        while (!running.isEmpty()) {
+            double now;
+            int node;
+            running.pop(now, node);
+            int readyBefore = timed.getNumReadyMatches();
+            timed.reportResult(node, picker.player1Wins());
+            eventMakespan = now;
+            if (timed.getNumReadyMatches() == readyBefore) { // One left, one released: it sits at the end
+                running.push(now + duration[timed.getReadyMatch(readyBefore - 1)], timed.getReadyMatch(readyBefore - 1));
+            }
+        }
+
+        // Lockstep: round r starts when every match of round r - 1 has finished
+        double roundStart = 0.0, previousRoundStart = 0.0, lockstepWait = 0.0;
+        int lockstepMatches = 0;
+        for (int round = 1; round <= timed.getNumRounds(); ++round) {
+            int firstNode = bracketSize >> round; // Nodes of this round: [firstNode, 2 * firstNode)
+            double longest = 0.0;
+            for (int node = firstNode; node < 2 * firstNode; ++node) {
+                if (timed.getMatchId(node) == 0) {
+                    continue; // Walkover
+                }
+                if (duration[node] > longest) {
+                    longest = duration[node];
+                }
+                if (round > 1) {
+                    double feedersDone = previousRoundStart;
+                    for (int child = 2 * node; child <= 2 * node + 1; ++child) {
+                        if (timed.getMatchId(child) != 0 && previousRoundStart + duration[child] > feedersDone) {
+                            feedersDone = previousRoundStart + duration[child];
+                        }
+                    }
+                    lockstepWait += roundStart - feedersDone;
+                }
+                lockstepMatches++;
+            }
+            previousRoundStart = roundStart;
+            roundStart += longest;
+        }
+
+        cout << setw(10) << numPlayers << setw(14) << results << setw(12) << fixed << setprecision(1) << (elapsedMs * 1e6 / (results > 0 ? results : 1))
+             << setw(12) << peakReady << setw(16) << eventMakespan << setw(16) << roundStart
+             << setw(14) << (lockstepWait / (lockstepMatches > 0 ? lockstepMatches : 1)) << " min" << endl;
+        cout.unsetf(ios::fixed);
+    }
+}
+
+// --- Result corrections ---
+// Plays a whole event-driven bracket, then overturns random opening-round results one at a
+// time and replays whatever each correction voided. Compares the cost of a correction (stats
+// undo and replay included) with rerunning the event, and reports how many bracket slots a
+// correction revisits. An opening-round correction must leave the old winner 0-1 and the new
+// winner with a win and at most one loss; "bad stats" counts corrections that did not.
+void benchmarkBracketCorrections() {
+    cout << "\n=== Event-driven bracket: overturning opening-round results ===" << endl;
+    cout << setw(10) << "players" << setw(12) << "rounds" << setw(16) << "full run (ms)" << setw(16) << "us/correction"
+         << setw(16) << "slots touched" << setw(16) << "voided/corr." << setw(12) << "bad stats" << endl;
+
+    const int sizes[] = {64, 4096, 65536, 1048576};
+    const int NUM_CORRECTIONS = 1000;
+    for (int sizeIndex = 0; sizeIndex < 4; ++sizeIndex) {
+        int numPlayers = sizes[sizeIndex];
+        DynamicArray<Player> entrants;
+        makeSyntheticPlayers(numPlayers, entrants);
+
+        GameResultLogger logger;
+        MatchOutcomeModel model(777);
+        MatchIdSequence matchIds;
+        SimulationLog log(LogVerbosity::Silent, 4096);
+        EventDrivenBracket bracket(logger, model, matchIds, log);
+        logger.reservePlayers(numPlayers);
+        bracket.reservePlayers(numPlayers);
+        for (int i = 0; i < numPlayers; ++i) {
+            bracket.addPlayer(entrants[i]);
+        }
+        BenchClock::time_point start = BenchClock::now();
+        bracket.initializeBracket();
+        bracket.runToCompletion();
+        double fullRunMs = millisecondsSince(start);
+
+        int firstRoundNode = bracket.getBracketSize() / 2; // Opening round: [bracketSize / 2, bracketSize)
+        MatchOutcomeModel picker(numPlayers + 1);
+        long long slotsTouched = 0;
+        int corrections = 0;
+        int badStats = 0;
+        int voidedBefore = bracket.getMatchesVoided();
+        start = BenchClock::now();
+        for (int c = 0; c < NUM_CORRECTIONS; ++c) {
+            int node = firstRoundNode + static_cast<int>(picker.nextSeed() % static_cast<unsigned long long>(firstRoundNode));
+            if (bracket.getMatchId(node) == 0) {
+                continue; // Bye
+            }
+            Match played = bracket.getMatch(node);
+            bool player1Won = (played.winner.playerId == played.player1.playerId);
+            const PlayerStats* oldWinner = logger.findPlayerStats(played.winner.playerId);
+            const PlayerStats* newWinner = logger.findPlayerStats(player1Won ? played.player2.playerId : played.player1.playerId);
+            if (oldWinner->wins < 1 || oldWinner->losses > 1 || newWinner->wins != 0 || newWinner->losses != 1) {
+                badStats++;
+            }
+            slotsTouched += bracket.correctResult(node, !player1Won);
+            bracket.runToCompletion(); // Replays the voided matches on the path
+            if (oldWinner->wins != 0 || oldWinner->losses != 1 || newWinner->wins < 1 || newWinner->losses > 1) {
+                badStats++;
+            }
+            corrections++;
+        }
+        double correctionMs = millisecondsSince(start);
+
+        cout << setw(10) << numPlayers << setw(12) << bracket.getNumRounds() << setw(16) << fixed << setprecision(2) << fullRunMs
+             << setw(16) << (correctionMs * 1000.0 / (corrections > 0 ? corrections : 1))
+             << setw(16) << (static_cast<double>(slotsTouched) / (corrections > 0 ? corrections : 1))
+             << setw(16) << (static_cast<double>(bracket.getMatchesVoided() - voidedBefore) / (corrections > 0 ? corrections : 1))
+             << setw(12) << badStats << endl;
+        cout.unsetf(ios::fixed);
+    }
+}
+
+// --- Player stats lookup ---
+// The stats lookup GameResultLogger used before the hash index: a linear scan over the
+// tracked players, comparing ID strings. Kept here as the "before" baseline.
+class LinearStatsBaseline {
+private:
+    DynamicArray<PlayerStats> stats;
+
+public:
+    void addPlayer(const Player& player) { // No duplicate check: that scan alone is O(n^2) at 1M players
+        stats.pushBack(PlayerStats(player.playerId, player.playerName, player.ranking));
+    }
+
+    PlayerStats* find(const string& playerId) {
+        for (int i = 0; i < stats.size(); ++i) {
+            if (stats[i].playerId == playerId) {
+                return &stats[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void recordMatchOutcome(const Match& match) {
+        PlayerStats* p1Stats = find(match.player1.playerId);
+        PlayerStats* p2Stats = find(match.player2.playerId);
+        if (p1Stats != nullptr) {
+            if (match.winner.playerId == match.player1.playerId) p1Stats->recordWin(); else p1Stats->recordLoss();
+        }
+        if (p2Stats != nullptr) {
+            if (match.winner.playerId == match.player2.playerId) p2Stats->recordWin(); else p2Stats->recordLoss();
+        }
+    }
+};
+
+// Logs 10M random pairings across 1M players. The linear baseline is timed on a sample and
+// extrapolated.
+void benchmarkStatsIndex() {
+    const int NUM_PLAYERS = 1000000;
+    const long long NUM_MATCHES = 10000000;
+    const int BASELINE_SAMPLE = 2000;
+    cout << "\n=== GameResultLogger: " << NUM_MATCHES << " matches across " << NUM_PLAYERS << " players ===" << endl;
+
+    DynamicArray<Player> entrants;
+    makeSyntheticPlayers(NUM_PLAYERS, entrants);
+    MatchOutcomeModel picker(2024);
+    Match match(0);
+    match.played = true;
+
+    // Before: linear scan
+    LinearStatsBaseline baseline;
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        baseline.addPlayer(entrants[i]);
+    }
+    BenchClock::time_point start = BenchClock::now();
+    for (int m = 0; m < BASELINE_SAMPLE; ++m) {
+        match.player1 = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)];
+        match.player2 = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)];
+        match.winner = picker.player1Wins() ? match.player1 : match.player2;
+        baseline.recordMatchOutcome(match);
+    }
+    double baselineUsPerMatch = millisecondsSince(start) * 1000.0 / BASELINE_SAMPLE;
+
+    // After: hash index
+    GameResultLogger logger;
+    logger.reservePlayers(NUM_PLAYERS);
+    start = BenchClock::now();
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        logger.initializePlayerForStats(entrants[i]);
+    }
+    double registerMs = millisecondsSince(start);
+    start = BenchClock::now();
+    for (long long m = 0; m < NUM_MATCHES; ++m) {
+        match.matchId = static_cast<int>(m + 1);
+        match.player1 = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)];
+        match.player2 = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)];
+        match.winner = picker.player1Wins() ? match.player1 : match.player2;
+        logger.recordMatchOutcome(match);
+    }
+    double recordMs = millisecondsSince(start);
+    double indexedUsPerMatch = recordMs * 1000.0 / static_cast<double>(NUM_MATCHES);
+
+    cout << fixed << setprecision(3);
+    cout << "Linear scan:  " << baselineUsPerMatch << " us/match (sampled " << BASELINE_SAMPLE << " matches), "
+         << "estimated " << (baselineUsPerMatch * NUM_MATCHES / 1e6) << " s for all matches" << endl;
+    cout << "Hash index:   " << indexedUsPerMatch << " us/match, " << (recordMs / 1000.0) << " s for all matches"
+         << " (registering " << NUM_PLAYERS << " players: " << registerMs << " ms)" << endl;
+    cout << "Speedup:      " << setprecision(0) << (baselineUsPerMatch / indexedUsPerMatch) << "x" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Player profile lookups ---
+// One player's match list out of a 1M-match log across 100k players. "Before" is the old
+// displaySinglePlayerPerformance approach: copy the whole log into a CustomQueue and dequeue
+// through it. "After" follows the player's chain through the log.
+void benchmarkPlayerMatchIndex() {
+    const int NUM_PLAYERS = 100000;
+    const int NUM_MATCHES = 1000000;
+    const int BASELINE_LOOKUPS = 3;
+    const int INDEXED_LOOKUPS = 1000000;
+    cout << "\n=== Player profile lookups: " << NUM_MATCHES << " logged matches, " << NUM_PLAYERS << " players ===" << endl;
+
+    DynamicArray<Player> entrants;
+    makeSyntheticPlayers(NUM_PLAYERS, entrants);
+    GameResultLogger logger;
+    logger.reservePlayers(NUM_PLAYERS);
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        logger.initializePlayerForStats(entrants[i]);
+    }
+    MatchOutcomeModel picker(99);
+    Match match(0);
+    match.played = true;
+    CustomQueue<HistoricalMatch> queueLog; // The old log structure
+    for (int m = 0; m < NUM_MATCHES; ++m) {
+        match.matchId = m + 1;
+        match.player1 = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)];
+        match.player2 = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)];
+        match.winner = picker.player1Wins() ? match.player1 : match.player2;
+        logger.recordMatchOutcome(match);
+        queueLog.enqueue(logger.getLoggedMatch(m));
+    }
+
+    long long found = 0;
+    BenchClock::time_point start = BenchClock::now();
+    for (int lookup = 0; lookup < BASELINE_LOOKUPS; ++lookup) {
+        const string& playerId = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)].playerId;
+        CustomQueue<HistoricalMatch> tempAllMatches = queueLog;
+        while (!tempAllMatches.isEmpty()) {
+            HistoricalMatch currentMatch = tempAllMatches.dequeue();
+            if (currentMatch.player1Id == playerId || currentMatch.player2Id == playerId) {
+                found++;
+            }
+        }
+    }
+    double baselineUs = millisecondsSince(start) * 1000.0 / BASELINE_LOOKUPS;
+
+    DynamicArray<int> rows;
+    start = BenchClock::now();
+    for (int lookup = 0; lookup < INDEXED_LOOKUPS; ++lookup) {
+        rows.clear();
+        found += logger.collectPlayerMatchRows(entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)].playerId, rows);
+    }
+    double indexedUs = millisecondsSince(start) * 1000.0 / INDEXED_LOOKUPS;
+
+    cout << fixed << setprecision(3);
+    cout << "Copy + scan log:   " << baselineUs << " us/lookup (" << BASELINE_LOOKUPS << " lookups)" << endl;
+    cout << "Per-player chain:  " << indexedUs << " us/lookup (" << INDEXED_LOOKUPS << " lookups, ~"
+         << (2.0 * NUM_MATCHES / NUM_PLAYERS) << " matches per player)" << endl;
+    cout << "Speedup:           " << setprecision(0) << (baselineUs / indexedUs) << "x  [" << found << " rows]" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Columnar match log ---
+// 1M matches across 100k players, appended to the original linked-list log (one node with
+// six strings per match) and to ColumnarMatchLog. Reports heap bytes and allocations per
+// logged match, append time, and a sequential scan of the winner column. "Marginal" bytes are
+// measured over the second half of the matches, when every player is already interned.
+void benchmarkColumnarLog() {
+    const int NUM_PLAYERS = 100000;
+    const int NUM_MATCHES = 1000000;
+    cout << "\n=== Match history layout: " << NUM_MATCHES << " matches, " << NUM_PLAYERS << " players ===" << endl;
+
+    DynamicArray<Player> entrants;
+    makeSyntheticPlayers(NUM_PLAYERS, entrants);
+    DynamicArray<int> player1Of, player2Of;
+    player1Of.reserve(NUM_MATCHES);
+    player2Of.reserve(NUM_MATCHES);
+    MatchOutcomeModel picker(31337);
+    for (int m = 0; m < NUM_MATCHES; ++m) {
+        player1Of.pushBack(static_cast<int>(picker.nextSeed() % NUM_PLAYERS));
+        player2Of.pushBack(static_cast<int>(picker.nextSeed() % NUM_PLAYERS));
+    }
+
+    cout << setw(24) << "layout" << setw(14) << "bytes/match" << setw(12) << "marginal" << setw(14) << "allocs/match" << setw(14) << "ns/append" << endl;
+    cout << fixed << setprecision(1);
+    double baselineBytes;
+    {
+        long long bytesBefore = liveHeapBytes.load(), allocationsBefore = heapAllocations.load();
+        BenchClock::time_point start = BenchClock::now();
+        CustomQueue<HistoricalMatch> queueLog;
+        long long bytesAtHalf = 0;
+        for (int m = 0; m < NUM_MATCHES; ++m) {
+            if (m == NUM_MATCHES / 2) {
+                bytesAtHalf = liveHeapBytes.load();
+            }
+            const Player& player1 = entrants[player1Of[m]];
+            const Player& player2 = entrants[player2Of[m]];
+            const Player& winner = (m % 2 == 0) ? player1 : player2;
+            queueLog.enqueue(HistoricalMatch(m + 1, player1.playerId, player1.playerName, player2.playerId, player2.playerName,
+                                             winner.playerId, winner.playerName));
+        }
+        double appendNs = millisecondsSince(start) * 1e6 / NUM_MATCHES;
+        baselineBytes = static_cast<double>(liveHeapBytes.load() - bytesBefore) / NUM_MATCHES;
+        cout << setw(24) << "linked list of records" << setw(14) << baselineBytes
+             << setw(12) << (static_cast<double>(liveHeapBytes.load() - bytesAtHalf) / (NUM_MATCHES - NUM_MATCHES / 2))
+             << setw(14) << (static_cast<double>(heapAllocations.load() - allocationsBefore) / NUM_MATCHES) << setw(14) << appendNs << endl;
+    }
+    {
+        long long bytesBefore = liveHeapBytes.load(), allocationsBefore = heapAllocations.load();
+        BenchClock::time_point start = BenchClock::now();
+        ColumnarMatchLog columnarLog;
+        long long bytesAtHalf = 0;
+        for (int m = 0; m < NUM_MATCHES; ++m) {
+            if (m == NUM_MATCHES / 2) {
+                bytesAtHalf = liveHeapBytes.load();
+            }
+            const Player& player1 = entrants[player1Of[m]];
+            const Player& player2 = entrants[player2Of[m]];
+            const Player& winner = (m % 2 == 0) ? player1 : player2;
+            columnarLog.append(m + 1, player1.playerId, player1.playerName, player1.ranking, player2.playerId, player2.playerName,
+                               player2.ranking, winner.playerId, winner.playerName, MatchRecordType::Result, 1, 0);
+        }
+        double appendNs = millisecondsSince(start) * 1e6 / NUM_MATCHES;
+        double columnarBytes = static_cast<double>(liveHeapBytes.load() - bytesBefore) / NUM_MATCHES;
+        double columnarMarginal = static_cast<double>(liveHeapBytes.load() - bytesAtHalf) / (NUM_MATCHES - NUM_MATCHES / 2);
+        cout << setw(24) << "columnar + interning" << setw(14) << columnarBytes << setw(12) << columnarMarginal
+             << setw(14) << (static_cast<double>(heapAllocations.load() - allocationsBefore) / NUM_MATCHES) << setw(14) << appendNs << endl;
+        cout << "Memory reduction: " << (baselineBytes / columnarBytes) << "x overall, "
+             << (baselineBytes / columnarMarginal) << "x per additional match" << endl;
+
+        // Wins per player from the winner column, chunk by chunk
+        DynamicArray<int> winsPerPlayer;
+        for (int p = 0; p < columnarLog.getNumPlayers(); ++p) {
+            winsPerPlayer.pushBack(0);
+        }
+        const int SCAN_PASSES = 20;
+        start = BenchClock::now();
+        long long checksum = 0;
+        for (int pass = 0; pass < SCAN_PASSES; ++pass) {
+            for (int c = 0; c < columnarLog.getNumChunks(); ++c) {
+                const int* winners = columnarLog.getChunk(c).winner;
+                int rows = columnarLog.getRowsInChunk(c);
+                for (int r = 0; r < rows; ++r) {
+                    winsPerPlayer[winners[r]]++;
+                }
+            }
+            checksum += winsPerPlayer[pass];
+        }
+        double scanMs = millisecondsSince(start) / SCAN_PASSES;
+        cout << "Winner-column scan: " << setprecision(2) << scanMs << " ms per pass ("
+             << setprecision(0) << (NUM_MATCHES / scanMs / 1000.0) << "M rows/s) [" << checksum << "]" << endl;
+    }
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Match history file ---
+// Appends matches to a MatchHistoryFile at several sync batch sizes while a second thread
+// maps the same file and keeps refreshing, the way an analytics process would. The reader
+// checks that it only ever sees whole batches of intact records. Then times a player tally
+// straight off the mapping.
+void benchmarkHistoryFile() {
+    const char* path = "bench_match_history.bin";
+    const int NUM_PLAYERS = 1000;
+    DynamicArray<Player> players;
+    makeSyntheticPlayers(NUM_PLAYERS, players);
+    cout << "\n=== Match history file ===" << endl;
+    cout << fixed << setprecision(1);
+    cout << setw(12) << "sync every" << setw(12) << "records" << setw(14) << "ns/record" << setw(12) << "refreshes" << setw(12) << "bad views" << endl;
+
+    const int batchSizes[] = {1, 64, 4096};
+    for (int batch : batchSizes) {
+        const int numRecords = (batch == 1) ? 2000 : 200000;
+        MatchHistoryFile writer(batch);
+        if (!writer.create(path)) {
+            return;
+        }
+        atomic<bool> writing(true);
+        long long refreshes = 0, badViews = 0;
+        thread reader([&]() {
+            MatchHistoryFileReader view;
+            long long lastSeen = 0;
+            while (writing.load()) {
+                if (!view.open(path)) {
+                    badViews++;
+                    continue;
+                }
+                refreshes++;
+                long long seen = view.getNumRecords();
+                if (seen < lastSeen || (seen % batch != 0 && seen != numRecords)) {
+                    badViews++;
+                }
+                for (long long i = lastSeen; i < seen; ++i) {
+                    if (view.getRecord(i).matchId != i + 1) {
+                        badViews++;
+                        break;
+                    }
+                }
+                lastSeen = seen;
+            }
+        });
+
+        BenchClock::time_point start = BenchClock::now();
+        for (int m = 0; m < numRecords; ++m) {
+            unsigned long long key = mixKey(static_cast<unsigned long long>(m));
+            Match match(players[key % NUM_PLAYERS], players[(key >> 20) % NUM_PLAYERS], m + 1);
+            match.winner = (key & (1ULL << 40)) ? match.player1 : match.player2;
+            match.played = true;
+            writer.append(match, MatchRecordType::Result);
+        }
+        writer.flush();
+        double ns = millisecondsSince(start) * 1e6 / numRecords;
+        writing = false;
+        reader.join();
+        cout << setw(12) << batch << setw(12) << numRecords << setw(14) << ns << setw(12) << refreshes << setw(12) << badViews << endl;
+    }
+
+    // The last file holds 200k records
+    MatchHistoryFileReader history;
+    if (history.open(path)) {
+        const int TALLY_PASSES = 20;
+        BenchClock::time_point start = BenchClock::now();
+        long long involved = 0;
+        for (int pass = 0; pass < TALLY_PASSES; ++pass) {
+            int wins, losses;
+            involved += history.tallyPlayer(players[pass].playerId, wins, losses);
+        }
+        double tallyMs = millisecondsSince(start) / TALLY_PASSES;
+        cout << "Player tally over the mapped file: " << setprecision(2) << tallyMs << " ms for "
+             << history.getNumRecords() << " records [" << involved << "]" << endl;
+    }
+    remove(path);
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Match history queries ---
+// 20M matches across 1M players: the first quarter is a group stage (groups of 8 players,
+// 28 matches per group), the rest random bracket-style pairings over 20 rounds, with about
+// 1 in 1000 results overturned. Point queries (head-to-head, one group) go through the
+// MatchQueryEngine indexes; "before" is a scan of the log's player columns. Aggregates are
+// timed as full passes over the columns.
+void benchmarkMatchQueries() {
+    const int NUM_PLAYERS = 1000000;
+    const int NUM_MATCHES = 20000000;
+    const int GROUP_SIZE = 8;
+    const int NUM_GROUPS = NUM_PLAYERS / GROUP_SIZE;
+    const int GROUP_MATCHES = NUM_GROUPS * GROUP_SIZE * (GROUP_SIZE - 1) / 2;
+    DynamicArray<Player> entrants;
+    makeSyntheticPlayers(NUM_PLAYERS, entrants);
+    cout << "\n=== Match history queries: " << NUM_MATCHES << " matches, " << NUM_PLAYERS << " players ===" << endl;
+    cout << fixed << setprecision(2);
+
+    ColumnarMatchLog matchLog;
+    BenchClock::time_point start = BenchClock::now();
+    int groupPlayerA = 0, groupPlayerB = 1;
+    for (int m = 0; m < NUM_MATCHES; ++m) {
+        unsigned long long key = mixKey(static_cast<unsigned long long>(m));
+        int player1, player2, round, group;
+        if (m < GROUP_MATCHES) { // Every pair within each group, group by group
+            int g = m / (GROUP_SIZE * (GROUP_SIZE - 1) / 2);
+            player1 = g * GROUP_SIZE + groupPlayerA;
+            player2 = g * GROUP_SIZE + groupPlayerB;
+            if (++groupPlayerB == GROUP_SIZE) {
+                groupPlayerB = ++groupPlayerA + 1;
+                if (groupPlayerB == GROUP_SIZE) {
+                    groupPlayerA = 0;
+                    groupPlayerB = 1;
+                }
+            }
+            round = 1 + groupPlayerA;
+            group = g + 1;
+        } else {
+            player1 = static_cast<int>(key % NUM_PLAYERS);
+            player2 = static_cast<int>((key >> 24) % NUM_PLAYERS);
+            if (player2 == player1) {
+                player2 = (player1 + 1) % NUM_PLAYERS;
+            }
+            round = 1 + static_cast<int>(static_cast<long long>(m - GROUP_MATCHES) * 20 / (NUM_MATCHES - GROUP_MATCHES));
+            group = 0;
+        }
+        const Player& first = entrants[player1];
+        const Player& second = entrants[player2];
+        const Player& winner = ((key >> 50) % 3 == 0) ? second : first; // player1 wins about 2 in 3
+        MatchRecordType type = ((key >> 40) % 1000 == 0) ? MatchRecordType::Overturned : MatchRecordType::Result;
+        matchLog.append(m + 1, first.playerId, first.playerName, first.ranking, second.playerId, second.playerName,
+                        second.ranking, winner.playerId, winner.playerName, type, round, group);
+    }
+    cout << "Logging:            " << (millisecondsSince(start) / 1000.0) << " s" << endl;
+
+    long long bytesBefore = liveHeapBytes.load();
+    MatchQueryEngine queries(matchLog);
+    start = BenchClock::now();
+    queries.update();
+    double buildMs = millisecondsSince(start);
+    cout << "Index build:        " << (buildMs / 1000.0) << " s (" << (buildMs * 1e6 / NUM_MATCHES) << " ns/row, "
+         << (static_cast<double>(liveHeapBytes.load() - bytesBefore) / NUM_MATCHES) << " bytes/row, "
+         << queries.getNumPairs() << " pairs)" << endl;
+
+    // Head-to-head of pairs sampled from the log, indexed vs a scan of the player columns
+    const int POINT_QUERIES = 100000;
+    start = BenchClock::now();
+    long long meetings = 0;
+    for (int q = 0; q < POINT_QUERIES; ++q) {
+        int row = static_cast<int>(mixKey(static_cast<unsigned long long>(q) + 7777) % NUM_MATCHES);
+        HistoricalMatch sample = matchLog.getMatch(row);
+        MatchQueryEngine::HeadToHead record;
+        queries.headToHead(sample.player1Id, sample.player2Id, record);
+        meetings += record.records;
+    }
+    double indexedUs = millisecondsSince(start) * 1000.0 / POINT_QUERIES;
+
+    const int SCAN_QUERIES = 5;
+    start = BenchClock::now();
+    long long scannedMeetings = 0;
+    for (int q = 0; q < SCAN_QUERIES; ++q) {
+        int row = static_cast<int>(mixKey(static_cast<unsigned long long>(q) + 7777) % NUM_MATCHES);
+        HistoricalMatch sample = matchLog.getMatch(row);
+        int a = matchLog.findPlayer(sample.player1Id);
+        int b = matchLog.findPlayer(sample.player2Id);
+        for (int c = 0; c < matchLog.getNumChunks(); ++c) {
+            const ColumnarMatchLog::Chunk& chunk = matchLog.getChunk(c);
+            int numRows = matchLog.getRowsInChunk(c);
+            for (int r = 0; r < numRows; ++r) {
+                scannedMeetings += ((chunk.player1[r] == a) & (chunk.player2[r] == b)) | ((chunk.player1[r] == b) & (chunk.player2[r] == a));
+            }
+        }
+    }
+    double scanUs = millisecondsSince(start) * 1000.0 / SCAN_QUERIES;
+    cout << "Head-to-head:       " << indexedUs << " us indexed vs " << (scanUs / 1000.0) << " ms column scan ("
+         << (scanUs / indexedUs) << "x) [" << meetings << ", " << scannedMeetings << "]" << endl;
+
+    start = BenchClock::now();
+    long long groupRows = 0;
+    DynamicArray<int> rows;
+    for (int q = 0; q < POINT_QUERIES; ++q) {
+        rows.clear();
+        groupRows += queries.collectGroupMatches(1 + static_cast<int>(mixKey(static_cast<unsigned long long>(q)) % NUM_GROUPS), rows);
+    }
+    cout << "Group matches:      " << (millisecondsSince(start) * 1000.0 / POINT_QUERIES) << " us per group [" << groupRows << "]" << endl;
+
+    rows.clear();
+    start = BenchClock::now();
+    int roundRows = queries.collectRoundMatches(10, false, rows);
+    cout << "Bracket round 10:   " << millisecondsSince(start) << " ms for " << roundRows << " rows" << endl;
+
+    const int AGGREGATE_PASSES = 5;
+    start = BenchClock::now();
+    long long upsets = 0;
+    for (int pass = 0; pass < AGGREGATE_PASSES; ++pass) {
+        upsets = queries.countUpsets();
+    }
+    double upsetMs = millisecondsSince(start) / AGGREGATE_PASSES;
+    cout << "Upset count:        " << upsetMs << " ms per pass (" << setprecision(0) << (NUM_MATCHES / upsetMs / 1000.0)
+         << "M rows/s) [" << upsets << "]" << setprecision(2) << endl;
+
+    start = BenchClock::now();
+    MatchQueryEngine::TierTable table;
+    for (int pass = 0; pass < AGGREGATE_PASSES; ++pass) {
+        queries.tierWinRates(NUM_PLAYERS / 8, table);
+    }
+    double tierMs = millisecondsSince(start) / AGGREGATE_PASSES;
+    cout << "Tier win rates:     " << tierMs << " ms per pass (" << setprecision(0) << (NUM_MATCHES / tierMs / 1000.0)
+         << "M rows/s) [" << table.wins[0][7] << "]" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Leaderboard ---
+// 1M players and 10M results. Every result moves both players on the win-count and win-rate
+// leaderboards. "Before" is what a standings screen had to do without them: sort every
+// player for each poll. Reports the cost of a result, a top-100 poll and a rank lookup.
+void benchmarkLeaderboard() {
+    const int NUM_PLAYERS = 1000000;
+    const int NUM_RESULTS = 10000000;
+    cout << "\n=== Leaderboard: " << NUM_PLAYERS << " players, " << NUM_RESULTS << " results ===" << endl;
+    cout << fixed << setprecision(2);
+
+    PlayerLeaderboard byWins(LeaderboardOrder::Wins);
+    PlayerLeaderboard byWinRate(LeaderboardOrder::WinRate);
+    int* wins = new int[NUM_PLAYERS];
+    int* losses = new int[NUM_PLAYERS];
+    PlayerStats record; // Scratch stats handed to the boards
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        wins[p] = losses[p] = 0;
+        byWins.addPlayer(p, record);
+        byWinRate.addPlayer(p, record);
+    }
+
+    BenchClock::time_point start = BenchClock::now();
+    for (int m = 0; m < NUM_RESULTS; ++m) {
+        unsigned long long key = mixKey(static_cast<unsigned long long>(m));
+        int winner = static_cast<int>(key % NUM_PLAYERS);
+        int loser = static_cast<int>((key >> 24) % NUM_PLAYERS);
+        if (winner == loser) {
+            continue;
+        }
+        wins[winner]++;
+        losses[loser]++;
+        record.wins = wins[winner];
+        record.losses = losses[winner];
+        byWins.updatePlayer(winner, record);
+        byWinRate.updatePlayer(winner, record);
+        record.wins = wins[loser];
+        record.losses = losses[loser];
+        byWins.updatePlayer(loser, record);
+        byWinRate.updatePlayer(loser, record);
+    }
+    double resultUs = millisecondsSince(start) * 1000.0 / NUM_RESULTS;
+    cout << "Result (2 players x 2 boards): " << resultUs << " us" << endl;
+
+    const int POLLS = 10000;
+    start = BenchClock::now();
+    long long checksum = 0;
+    for (int q = 0; q < POLLS; ++q) {
+        DynamicArray<int> top;
+        byWins.collectTop(100, top);
+        checksum += top[q % 100];
+    }
+    double topUs = millisecondsSince(start) * 1000.0 / POLLS;
+
+    start = BenchClock::now();
+    for (int q = 0; q < POLLS * 10; ++q) {
+        checksum += byWinRate.placeOf(static_cast<int>(mixKey(static_cast<unsigned long long>(q)) % NUM_PLAYERS));
+    }
+    double placeUs = millisecondsSince(start) * 1000.0 / (POLLS * 10);
+
+    // Baseline: sort all players by wins for one poll
+    const int SORT_POLLS = 5;
+    int* order = new int[NUM_PLAYERS];
+    start = BenchClock::now();
+    for (int q = 0; q < SORT_POLLS; ++q) {
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            order[p] = p;
+        }
+        sort(order, order + NUM_PLAYERS, [&](int a, int b) {
+            if (wins[a] != wins[b]) return wins[a] > wins[b];
+            if (losses[a] != losses[b]) return losses[a] < losses[b];
+            return a < b;
+        });
+        checksum += order[0];
+    }
+    double sortUs = millisecondsSince(start) * 1000.0 / SORT_POLLS;
+    cout << "Top-100 poll:  " << topUs << " us (full sort: " << (sortUs / 1000.0) << " ms, " << (sortUs / topUs) << "x)" << endl;
+    cout << "Rank of player: " << placeUs << " us [" << checksum << "]" << endl;
+
+    delete[] order;
+    delete[] wins;
+    delete[] losses;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Season ratings ---
+// Glicko recompute of a 50M-match season across 1M players, in periods of 10k matches.
+// Every player has a hidden strength; the stronger side of a match wins with the logistic
+// probability of the strength gap. Runs on one thread and on every core, checks that both
+// give the same ratings, and reports how well the ratings recover the hidden strengths.
+void benchmarkSeasonRatings() {
+    const int NUM_PLAYERS = 1000000;
+    const int NUM_MATCHES = 50000000;
+    cout << "\n=== Season ratings: " << NUM_MATCHES << " matches across " << NUM_PLAYERS << " players ===" << endl;
+    cout << fixed << setprecision(2);
+
+    GlickoSeasonRater season(GlickoSeasonRater::DEFAULT_PERIOD_MATCHES);
+    double* strength = new double[NUM_PLAYERS];
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        season.addPlayer("PL" + to_string(p), "Player " + to_string(p));
+        strength[p] = 1000.0 + 1000.0 * static_cast<double>(mixKey(static_cast<unsigned long long>(p) + 99) % 10000) / 10000.0;
+    }
+    for (int m = 0; m < NUM_MATCHES; ++m) {
+        unsigned long long key = mixKey(static_cast<unsigned long long>(m));
+        int player1 = static_cast<int>(key % NUM_PLAYERS);
+        int player2 = static_cast<int>((key >> 24) % NUM_PLAYERS);
+        if (player1 == player2) {
+            player2 = (player2 + 1) % NUM_PLAYERS;
+        }
+        double player1Chance = EloRating::expectedScore(strength[player1], strength[player2]);
+        double draw = static_cast<double>(key >> 44) / static_cast<double>(1ULL << 20);
+        season.addMatch(player1, player2, (draw < player1Chance) ? 1 : 2);
+    }
+
+    BenchClock::time_point start = BenchClock::now();
+    season.recompute(1);
+    double oneThreadMs = millisecondsSince(start);
+    double* singleThreaded = new double[NUM_PLAYERS];
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        singleThreaded[p] = season.getRating(p);
+    }
+    cout << "1 thread:   " << (oneThreadMs / 1000.0) << " s (" << (NUM_MATCHES / oneThreadMs / 1000.0) << "M matches/s, "
+         << season.getNumPeriods() << " periods)" << endl;
+
+    int cores = static_cast<int>(thread::hardware_concurrency());
+    if (cores > 1) {
+        start = BenchClock::now();
+        season.recompute(cores);
+        double allCoresMs = millisecondsSince(start);
+        int mismatches = 0;
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            if (season.getRating(p) != singleThreaded[p]) {
+                mismatches++;
+            }
+        }
+        cout << cores << " threads: " << (allCoresMs / 1000.0) << " s (" << (oneThreadMs / allCoresMs) << "x, "
+             << mismatches << " ratings differ from 1 thread)" << endl;
+    } else {
+        cout << "Only one hardware thread: multi-threaded run skipped" << endl;
+    }
+
+    // How well the ratings track the hidden strengths: rating gap between the top and bottom tenth
+    double strongSum = 0.0, weakSum = 0.0;
+    int strong = 0, weak = 0;
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        if (strength[p] >= 1900.0) { strongSum += season.getRating(p); strong++; }
+        if (strength[p] < 1100.0) { weakSum += season.getRating(p); weak++; }
+    }
+    cout << "Mean rating, strongest tenth: " << (strongSum / strong) << ", weakest tenth: " << (weakSum / weak)
+         << " (hidden strengths 1950 vs 1050)" << endl;
+
+    delete[] strength;
+    delete[] singleThreaded;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Concurrent recording ---
+// 1M results across 100k players recorded into one GameResultLogger by 1 to 64 threads
+// (thread t takes every T-th match). Checks every player's wins and losses against a
+// sequential tally and that the log holds each match once, and reports how many log rows
+// ended up behind an earlier match ID (combined batches are merged in ID order, but a batch
+// can still start below the end of the previous one) and the cost of reading the log back
+// in match-ID order. Ratings depend on the order results are applied, so they are not compared.
+void benchmarkConcurrentRecording() {
+    const int NUM_PLAYERS = 100000;
+    const int NUM_MATCHES = 1000000;
+    const int THREAD_COUNTS[] = {1, 2, 4, 8, 16, 32, 64};
+    cout << "\n=== Concurrent recording: " << NUM_MATCHES << " results across " << NUM_PLAYERS << " players ===" << endl;
+    cout << fixed << setprecision(2);
+
+    DynamicArray<Player> entrants;
+    makeSyntheticPlayers(NUM_PLAYERS, entrants);
+    int* expectedWins = new int[NUM_PLAYERS];
+    int* expectedLosses = new int[NUM_PLAYERS];
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        expectedWins[p] = expectedLosses[p] = 0;
+    }
+    for (int m = 0; m < NUM_MATCHES; ++m) {
+        unsigned long long key = mixKey(static_cast<unsigned long long>(m));
+        int winner = static_cast<int>(key % NUM_PLAYERS);
+        int loser = static_cast<int>((key >> 24) % NUM_PLAYERS);
+        if (winner == loser) {
+            loser = (loser + 1) % NUM_PLAYERS;
+        }
+        expectedWins[winner]++;
+        expectedLosses[loser]++;
+    }
+
+    double oneThreadMs = 0.0;
+    for (int threadCount : THREAD_COUNTS) {
+        GameResultLogger* logger = new GameResultLogger();
+        logger->reservePlayers(NUM_PLAYERS);
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            logger->initializePlayerForStats(entrants[p]);
+        }
+
+        BenchClock::time_point start = BenchClock::now();
+        thread* workers = new thread[threadCount];
+        for (int t = 0; t < threadCount; ++t) {
+            workers[t] = thread([&, t]() {
+                Match match(0);
+                match.played = true;
+                for (int m = t; m < NUM_MATCHES; m += threadCount) {
+                    unsigned long long key = mixKey(static_cast<unsigned long long>(m));
+                    int winner = static_cast<int>(key % NUM_PLAYERS);
+                    int loser = static_cast<int>((key >> 24) % NUM_PLAYERS);
+                    if (winner == loser) {
+                        loser = (loser + 1) % NUM_PLAYERS;
+                    }
+                    match.matchId = m + 1;
+                    match.player1 = entrants[winner];
+                    match.player2 = entrants[loser];
+                    match.winner = match.player1;
+                    logger->recordMatchOutcome(match);
+                }
+            });
+        }
+        for (int t = 0; t < threadCount; ++t) {
+            workers[t].join();
+        }
+        double elapsedMs = millisecondsSince(start);
+        delete[] workers;
+        if (threadCount == 1) {
+            oneThreadMs = elapsedMs;
+        }
+
+        int wrongRecords = 0;
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            const PlayerStats& stats = logger->getTrackedPlayerStats(p);
+            if (stats.wins != expectedWins[p] || stats.losses != expectedLosses[p]) {
+                wrongRecords++;
+            }
+        }
+        const ColumnarMatchLog& log = logger->getMatchLog();
+        DynamicArray<char> seen(NUM_MATCHES + 1);
+        for (int m = 0; m <= NUM_MATCHES; ++m) {
+            seen.pushBack(0);
+        }
+        int duplicates = 0, outOfOrder = 0, highestId = 0;
+        for (int c = 0; c < log.getNumChunks(); ++c) {
+            const ColumnarMatchLog::Chunk& chunk = log.getChunk(c);
+            for (int r = 0; r < log.getRowsInChunk(c); ++r) {
+                int matchId = chunk.matchId[r];
+                if (seen[matchId]) {
+                    duplicates++;
+                }
+                seen[matchId] = 1;
+                if (matchId < highestId) {
+                    outOfOrder++;
+                } else {
+                    highestId = matchId;
+                }
+            }
+        }
+        start = BenchClock::now();
+        DynamicArray<int> ordered;
+        logger->collectRowsInMatchIdOrder(ordered);
+        double mergeMs = millisecondsSince(start);
+        int unsorted = 0;
+        for (int i = 1; i < ordered.size(); ++i) {
+            if (logger->getLoggedMatch(ordered[i]).matchId < logger->getLoggedMatch(ordered[i - 1]).matchId) {
+                unsorted++;
+            }
+        }
+        cout << setw(2) << threadCount << " threads: " << (elapsedMs / 1000.0) << " s ("
+             << (NUM_MATCHES / elapsedMs / 1000.0) << "M results/s, " << (oneThreadMs / elapsedMs) << "x) | "
+             << log.size() << " rows, " << duplicates << " duplicates, " << outOfOrder << " behind an earlier ID, "
+             << wrongRecords << " players with a wrong record | ID-order read: " << mergeMs << " ms, "
+             << unsorted << " out of order" << endl;
+        delete logger;
+    }
+    int cores = static_cast<int>(thread::hardware_concurrency());
+    cout << "(" << cores << " hardware thread" << (cores == 1 ? "" : "s") << " on this machine)" << endl;
+
+    delete[] expectedWins;
+    delete[] expectedLosses;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Report allocations ---
+// Stream buffer that drops everything written to it, so reports are formatted but not kept.
+class DiscardBuffer : public streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    streamsize xsputn(const char*, streamsize count) override { return count; }
+};
+
+// A full reports session over a 1M-match log across 100k players: the recent results, the
+// whole log, 1000 player profiles, and a listing of bracket-sized queues (50k scheduled
+// matches, 100k waiting players) plus a stack. "Before" reads the way the displays used to:
+// every log row rebuilt as a HistoricalMatch, every queue deep-copied and dequeued. "After"
+// is the display methods themselves and range-for over the containers. Output goes to a
+// DiscardBuffer; reports heap allocations and time for each.
+void benchmarkReportAllocations() {
+    const int NUM_PLAYERS = 100000;
+    const int NUM_MATCHES = 1000000;
+    const int PROFILES = 1000;
+    const int RECENT = GameResultLogger::DEFAULT_RECENT_MATCHES;
+    cout << "\n=== Report allocations: " << NUM_MATCHES << " logged matches, " << NUM_PLAYERS << " players ===" << endl;
+
+    DynamicArray<Player> entrants;
+    makeSyntheticPlayers(NUM_PLAYERS, entrants);
+    GameResultLogger logger;
+    logger.reservePlayers(NUM_PLAYERS);
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        logger.initializePlayerForStats(entrants[i]);
+    }
+    MatchOutcomeModel picker(43);
+    Match match(0);
+    match.played = true;
+    CustomQueue<Match> scheduled;
+    CustomQueue<Player> waiting;
+    CustomStack<Player> eliminated;
+    for (int m = 0; m < NUM_MATCHES; ++m) {
+        match.matchId = m + 1;
+        match.player1 = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)];
+        match.player2 = entrants[static_cast<int>(picker.nextSeed() % NUM_PLAYERS)];
+        match.winner = picker.player1Wins() ? match.player1 : match.player2;
+        logger.recordMatchOutcome(match);
+        if (m < NUM_PLAYERS / 2) {
+            scheduled.enqueue(match);
+        }
+    }
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        waiting.enqueue(entrants[i]);
+        eliminated.push(entrants[i]);
+    }
+    DynamicArray<int> profilePlayers;
+    for (int i = 0; i < PROFILES; ++i) {
+        profilePlayers.pushBack(static_cast<int>(picker.nextSeed() % NUM_PLAYERS));
+    }
+
+    DiscardBuffer discard;
+    streambuf* console = cout.rdbuf(&discard);
+
+    // Before: copies
+    long long allocationsBefore = heapAllocations.load();
+    BenchClock::time_point start = BenchClock::now();
+    for (int k = 0; k < logger.getNumRecentMatches() && k < RECENT; ++k) {
+        cout << logger.getRecentMatch(k) << endl;
+    }
+    for (int row = 0; row < logger.getNumLoggedMatches(); ++row) {
+        cout << (row + 1) << ". " << logger.getLoggedMatch(row) << endl;
+    }
+    DynamicArray<int> rows;
+    for (int i = 0; i < PROFILES; ++i) {
+        rows.clear();
+        logger.collectPlayerMatchRows(entrants[profilePlayers[i]].playerId, rows);
+        for (int r = 0; r < rows.size(); ++r) {
+            cout << "    " << (r + 1) << ". " << logger.getLoggedMatch(rows[r]) << endl;
+        }
+    }
+    double logCopyMs = millisecondsSince(start);
+    long long logCopyAllocations = heapAllocations.load() - allocationsBefore;
+    allocationsBefore = heapAllocations.load();
+    start = BenchClock::now();
+    {
+        CustomQueue<Match> tempScheduled = scheduled;
+        while (!tempScheduled.isEmpty()) {
+            cout << tempScheduled.dequeue() << endl;
+        }
+        CustomQueue<Player> tempWaiting = waiting;
+        while (!tempWaiting.isEmpty()) {
+            cout << tempWaiting.dequeue() << endl;
+        }
+        CustomStack<Player> tempEliminated = eliminated;
+        while (!tempEliminated.isEmpty()) {
+            cout << tempEliminated.pop() << endl;
+        }
+    }
+    double queueCopyMs = millisecondsSince(start);
+    long long queueCopyAllocations = heapAllocations.load() - allocationsBefore;
+
+    // After: iteration
+    allocationsBefore = heapAllocations.load();
+    start = BenchClock::now();
+    logger.displayRecentMatches(RECENT);
+    logger.displayAllRecordedMatches();
+    for (int i = 0; i < PROFILES; ++i) {
+        logger.displaySinglePlayerPerformance(entrants[profilePlayers[i]].playerId);
+    }
+    double logIterateMs = millisecondsSince(start);
+    long long logIterateAllocations = heapAllocations.load() - allocationsBefore;
+    allocationsBefore = heapAllocations.load();
+    start = BenchClock::now();
+    for (const Match& scheduledMatch : scheduled) {
+        cout << scheduledMatch << endl;
+    }
+    for (const Player& player : waiting) {
+        cout << player << endl;
+    }
+    for (const Player& player : eliminated) {
+        cout << player << endl;
+    }
+    double queueIterateMs = millisecondsSince(start);
+    long long queueIterateAllocations = heapAllocations.load() - allocationsBefore;
+
+    cout.rdbuf(console);
+    cout << fixed << setprecision(1);
+    cout << "Log reports (recent " << RECENT << ", all rows, " << PROFILES << " profiles):" << endl;
+    cout << "  rebuilt rows:    " << logCopyAllocations << " allocations, " << logCopyMs << " ms" << endl;
+    cout << "  column printing: " << logIterateAllocations << " allocations, " << logIterateMs << " ms" << endl;
+    cout << "Queue/stack listings (" << scheduled.size() << " matches, " << waiting.size() << " + "
+         << eliminated.size() << " players):" << endl;
+    cout << "  copy + dequeue: " << queueCopyAllocations << " allocations, " << queueCopyMs << " ms" << endl;
+    cout << "  range-for:      " << queueIterateAllocations << " allocations, " << queueIterateMs << " ms" << endl;
+    cout << "Session total:    " << (logCopyAllocations + queueCopyAllocations) << " -> "
+         << (logIterateAllocations + queueIterateAllocations) << " allocations" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Ring-buffer queue ---
+// The bracket's queue traffic: fill a queue, then pass every item to a second queue and back,
+// the way winners move from winnersQueue to waitingPlayersQueue each round. CustomQueue
+// allocates a node per enqueue and copies the item in and out; RingBufferQueue moves it
+// between two rings that stop growing after the first pass. Reports time and heap
+// allocations per transfer for Player and Match payloads.
+template <typename Queue, typename T>
+void timeQueueTransfers(const char* label, const DynamicArray<T>& items, int passes) {
+    long long allocationsBefore = heapAllocations.load();
+    BenchClock::time_point start = BenchClock::now();
+    long long checksum = 0;
+    {
+        Queue first, second;
+        for (int i = 0; i < items.size(); ++i) {
+            first.enqueue(items[i]);
+        }
+        for (int pass = 0; pass < passes; ++pass) {
+            Queue& from = (pass % 2 == 0) ? first : second;
+            Queue& to = (pass % 2 == 0) ? second : first;
+            while (!from.isEmpty()) {
+                to.enqueue(from.dequeue());
+            }
+            checksum += to.size();
+        }
+    }
+    double elapsedMs = millisecondsSince(start);
+    long long transfers = static_cast<long long>(items.size()) * (passes + 1);
+    cout << "  " << label << (elapsedMs * 1e6 / transfers) << " ns, "
+         << (static_cast<double>(heapAllocations.load() - allocationsBefore) / transfers) << " allocations per transfer ["
+         << checksum << "]" << endl;
+}
+
+void benchmarkRingBufferQueue() {
+    const int NUM_ITEMS = 100000;
+    const int PASSES = 20;
+    cout << "\n=== Ring-buffer queue: " << NUM_ITEMS << " items passed between two queues " << PASSES << " times ===" << endl;
+    cout << fixed << setprecision(2);
+
+    DynamicArray<Player> players;
+    makeSyntheticPlayers(NUM_ITEMS, players);
+    DynamicArray<Match> matches(NUM_ITEMS);
+    for (int i = 0; i < NUM_ITEMS; ++i) {
+        Match match(players[i], players[NUM_ITEMS - 1 - i], i + 1);
+        match.played = true;
+        match.winner = match.player1;
+        matches.pushBack(match);
+    }
+
+    cout << "Player:" << endl;
+    timeQueueTransfers<CustomQueue<Player>>("CustomQueue:     ", players, PASSES);
+    timeQueueTransfers<RingBufferQueue<Player>>("RingBufferQueue: ", players, PASSES);
+    cout << "Match:" << endl;
+    timeQueueTransfers<CustomQueue<Match>>("CustomQueue:     ", matches, PASSES);
+    timeQueueTransfers<RingBufferQueue<Match>>("RingBufferQueue: ", matches, PASSES);
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Player flow ---
+// One registration-to-champion run over updated_player_info.csv (run from the repository
+// directory): load the CSV into the priority queue, move everyone to the main queue, check
+// them all in, hand them to a MatchScheduler the way main does, then seed, play the
+// 16-group stage and the bracket to a champion. Reports heap allocations per player for each
+// phase (almost all of them string buffers), averaged over repeated runs.
+void benchmarkPlayerFlow() {
+    const int RUNS = 200;
+    const int PHASES = 5;
+    const char* PHASE_NAMES[PHASES] = {"CSV load:          ", "Priority -> main:  ", "Check-in:          ",
+                                       "Transfer to event: ", "Seed, play, crown: "};
+    cout << "\n=== Player flow: registration to champion, " << RUNS << " runs ===" << endl;
+
+    long long phaseAllocations[PHASES] = {0, 0, 0, 0, 0};
+    long long players = 0;
+    DiscardBuffer discard;
+    streambuf* console = cout.rdbuf(&discard); // The registration system narrates every step
+    BenchClock::time_point start = BenchClock::now();
+    for (int run = 0; run < RUNS; ++run) {
+        GameResultLogger logger;
+        MatchOutcomeModel model(static_cast<unsigned int>(run + 1));
+        MatchIdSequence matchIds;
+        SimulationLog log(LogVerbosity::Silent, 4096);
+        MatchScheduler scheduler(logger, model, matchIds, log);
+        TournamentRegistrationSystem registration;
+
+        long long mark = heapAllocations.load();
+        registration.loadPlayersFromFile("updated_player_info.csv");
+        phaseAllocations[0] += heapAllocations.load() - mark;
+
+        mark = heapAllocations.load();
+        registration.processPriorityRegistrations();
+        phaseAllocations[1] += heapAllocations.load() - mark;
+
+        mark = heapAllocations.load();
+        registration.batchCheckIn(MAX_PLAYERS_UNIVERSAL);
+        phaseAllocations[2] += heapAllocations.load() - mark;
+
+        mark = heapAllocations.load();
+        PlayerQueue* checkedIn = registration.getCheckedInPlayersQueue();
+        while (!checkedIn->isEmpty()) {
+            scheduler.addPlayer(checkedIn->dequeue());
+        }
+        phaseAllocations[3] += heapAllocations.load() - mark;
+        players += scheduler.getNumInitialPlayers();
+
+        mark = heapAllocations.load();
+        scheduler.initializeTournament();
+        scheduler.runGroupStage(16);
+        scheduler.advanceToNextRound();
+        while (!scheduler.isTournamentOver()) {
+            if (!scheduler.createNextRoundPairings()) {
+                break;
+            }
+            scheduler.playAndProcessMatches();
+            if (!scheduler.advanceToNextRound()) {
+                break;
+            }
+        }
+        const Player& champion = scheduler.getTournamentWinner();
+        phaseAllocations[4] += heapAllocations.load() - mark;
+        if (champion.playerId == "") {
+            cerr << "Run " << run << " ended without a champion." << endl;
+        }
+    }
+    double elapsedMs = millisecondsSince(start);
+    cout.rdbuf(console);
+
+    if (players == 0) {
+        cout << "No players loaded (run from the directory holding updated_player_info.csv)." << endl;
+        return;
+    }
+    cout << fixed << setprecision(1);
+    long long total = 0;
+    for (int phase = 0; phase < PHASES; ++phase) {
+        cout << PHASE_NAMES[phase] << (static_cast<double>(phaseAllocations[phase]) / players) << " allocations per player" << endl;
+        total += phaseAllocations[phase];
+    }
+    cout << "Total:             " << (static_cast<double>(total) / players) << " allocations per player ("
+         << (players / RUNS) << " players, " << (elapsedMs * 1000.0 / RUNS) << " us per run)" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Player keys ---
+// Telling players apart by PlayerIdCodec key instead of by ID string. First the bare compare:
+// random pairs of synthetic players ("BP1".."BP100000", so strings share their prefix),
+// compared by playerId and by idKey. Then recording results, which finds both players' stats
+// and the winner's side by key: ns per recorded result over 100000 tracked players.
+void benchmarkPlayerKeys() {
+    const int NUM_PLAYERS = 100000;
+    const int NUM_PAIRS = 1 << 20;
+    const int PASSES = 20;
+    const int NUM_RESULTS = 1000000;
+    cout << "\n=== Player keys: " << NUM_PLAYERS << " players ===" << endl;
+
+    DynamicArray<Player> players;
+    makeSyntheticPlayers(NUM_PLAYERS, players);
+    DynamicArray<int> pairs(NUM_PAIRS * 2);
+    for (int i = 0; i < NUM_PAIRS * 2; ++i) {
+        pairs.pushBack(static_cast<int>(mixKey(i) % NUM_PLAYERS));
+    }
+
+    long long sameByString = 0;
+    BenchClock::time_point start = BenchClock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (int i = 0; i < NUM_PAIRS; ++i) {
+            sameByString += (players[pairs[2 * i]].playerId == players[pairs[2 * i + 1]].playerId) ? 1 : 0;
+        }
+    }
+    double stringMs = millisecondsSince(start);
+    long long sameByKey = 0;
+    start = BenchClock::now();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (int i = 0; i < NUM_PAIRS; ++i) {
+            sameByKey += (players[pairs[2 * i]].idKey == players[pairs[2 * i + 1]].idKey) ? 1 : 0;
+        }
+    }
+    double keyMs = millisecondsSince(start);
+    double compares = static_cast<double>(NUM_PAIRS) * PASSES;
+    cout << fixed << setprecision(2);
+    cout << "Compare by playerId: " << (stringMs * 1e6 / compares) << " ns [" << sameByString << "]" << endl;
+    cout << "Compare by idKey:    " << (keyMs * 1e6 / compares) << " ns [" << sameByKey << "]" << endl;
+
+    GameResultLogger logger;
+    logger.reservePlayers(NUM_PLAYERS);
+    for (int i = 0; i < NUM_PLAYERS; ++i) {
+        logger.initializePlayerForStats(players[i]);
+    }
+    start = BenchClock::now();
+    for (int i = 0; i < NUM_RESULTS; ++i) {
+        int first = pairs[(2 * i) % (NUM_PAIRS * 2)];
+        int second = (first + 1 + static_cast<int>(mixKey(i) % (NUM_PLAYERS - 1))) % NUM_PLAYERS;
+        Match match(players[first], players[second], i + 1);
+        match.played = true;
+        match.winner = (i % 3 == 0) ? match.player2 : match.player1;
+        logger.recordMatchOutcome(match);
+    }
+    double recordMs = millisecondsSince(start);
+    cout << "Record a result:     " << (recordMs * 1e6 / NUM_RESULTS) << " ns (incl. building the Match)" << endl;
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+// --- Engine suite ---
+// Micro and macro benchmarks of the engine's public operations at field sizes of 64 (the
+// championship), 10k and 1M players, written as JSON for tracking regressions between releases
+// (--json <file>, default tournament_suite.json). Each case sets up a field of the given size
+// and times only its measured part, repeated until at least SUITE_MIN_MS has been timed.
+// Operations whose setup is quadratic in the field skip the sizes they cannot reach in
+// reasonable time; the JSON records the skip and why, so the size shows up once it is fixed.
+const int SUITE_FIELD_SIZES[] = {64, 10000, 1000000};
+const int NUM_SUITE_FIELD_SIZES = sizeof(SUITE_FIELD_SIZES) / sizeof(SUITE_FIELD_SIZES[0]);
+const double SUITE_MIN_MS = 100.0;
+const int SUITE_MAX_REPETITIONS = 100000;
+const long long SUITE_SCAN_BUDGET = 20000000; // Node visits per repetition for O(n)-per-op cases
+string suiteJsonPath = "tournament_suite.json";
+volatile long long suiteSink = 0; // Keeps measured results alive
+
+// Accumulates the time and heap allocations of the measured parts of a case.
+class SuiteTimer {
+private:
+    BenchClock::time_point started;
+    long long allocationsAtStart;
+
+public:
+    double milliseconds;
+    long long allocations;
+
+    SuiteTimer() : allocationsAtStart(0), milliseconds(0.0), allocations(0) {}
+
+    void start() {
+        allocationsAtStart = heapAllocations.load();
+        started = BenchClock::now();
+    }
+    void stop() {
+        milliseconds += millisecondsSince(started);
+        allocations += heapAllocations.load() - allocationsAtStart;
+    }
+};
+
+// One case: runs once at `fieldSize`, timing its measured part with `timer`; returns the
+// number of operations timed.
+struct SuiteCase {
+    const char* name;
+    const char* operation; // What one operation is
+    int maxFieldSize;      // Larger sizes are skipped
+    const char* skipReason;
+    long long (*run)(int fieldSize, SuiteTimer& timer);
+};
+
+// Operations per repetition for cases whose every operation walks the whole field.
+long long scanOperationsFor(int fieldSize) {
+    long long operations = SUITE_SCAN_BUDGET / fieldSize;
+    if (operations > fieldSize) operations = fieldSize;
+    return (operations < 1) ? 1 : operations;
+}
+
+// Synthetic field with the CSV's tier mix: the top quarter are early birds, the bottom tenth
+// wildcards, the rest regulars (so the group stage can always form its 16 groups).
+void makeTieredPlayers(int count, DynamicArray<Player>& out) {
+    makeSyntheticPlayers(count, out);
+    for (int i = 0; i < count; ++i) {
+        if (i < count / 4) out[i].originalPriority = "early birds";
+        else if (i >= count - count / 10) out[i].originalPriority = "wildcard";
+        out[i].registrationStatus = out[i].originalPriority;
+    }
+}
+
+// Fisher-Yates shuffle driven by mixKey, so every run sees the same order.
+void shufflePlayers(DynamicArray<Player>& players, unsigned long long seed) {
+    for (int i = players.size() - 1; i > 0; --i) {
+        int j = static_cast<int>(mixKey(seed + i) % static_cast<unsigned long long>(i + 1));
+        if (i != j) {
+            swap(players[i], players[j]);
+        }
+    }
+}
+
+void drainPlayerQueue(PlayerQueue& queue) { // PlayerQueue does not free its nodes itself
+    while (!queue.isEmpty()) {
+        queue.dequeue();
+    }
+}
+
+long long suiteCustomQueue(int fieldSize, SuiteTimer& timer) {
+    CustomQueue<int> queue;
+    long long sum = 0;
+    timer.start();
+    for (int i = 0; i < fieldSize; ++i) {
+        queue.enqueue(i);
+    }
+    while (!queue.isEmpty()) {
+        sum += queue.dequeue();
+    }
+    timer.stop();
+    suiteSink += sum;
+    return 2LL * fieldSize;
+}
+
+long long suiteCustomStack(int fieldSize, SuiteTimer& timer) {
+    CustomStack<int> stack;
+    long long sum = 0;
+    timer.start();
+    for (int i = 0; i < fieldSize; ++i) {
+        stack.push(i);
+    }
+    while (!stack.isEmpty()) {
+        sum += stack.pop();
+    }
+    timer.stop();
+    suiteSink += sum;
+    return 2LL * fieldSize;
+}
+
+// Late registrations slotted into a full main queue (even ranks queued, odd ranks inserted).
+long long suitePlayerQueueInsert(int fieldSize, SuiteTimer& timer) {
+    long long operations = scanOperationsFor(fieldSize);
+    PlayerQueue queue;
+    for (int i = 0; i < fieldSize; ++i) {
+        queue.enqueue(Player("BP" + to_string(i + 1), "Bench Player", 2 * (i + 1)));
+    }
+    DynamicArray<Player> late(static_cast<int>(operations));
+    for (long long k = 0; k < operations; ++k) {
+        int rank = 2 * static_cast<int>(mixKey(k) % fieldSize) + 1;
+        late.pushBack(Player("LP" + to_string(k + 1), "Late Player", rank));
+    }
+    timer.start();
+    for (int k = 0; k < late.size(); ++k) {
+        queue.insertByRanking(std::move(late[k]));
+    }
+    timer.stop();
+    suiteSink += queue.size();
+    drainPlayerQueue(queue);
+    return operations;
+}
+
+// Withdrawals of random queued players by ID.
+long long suitePlayerQueueRemove(int fieldSize, SuiteTimer& timer) {
+    long long operations = scanOperationsFor(fieldSize);
+    PlayerQueue queue;
+    for (int i = 0; i < fieldSize; ++i) {
+        queue.enqueue(Player("BP" + to_string(i + 1), "Bench Player", i + 1));
+    }
+    DynamicArray<string> withdrawn(static_cast<int>(operations));
+    for (long long k = 0; k < operations; ++k) {
+        withdrawn.pushBack("BP" + to_string(mixKey(k) % fieldSize + 1)); // A repeat is a miss, a full scan
+    }
+    long long removed = 0;
+    timer.start();
+    for (int k = 0; k < withdrawn.size(); ++k) {
+        removed += queue.removePlayer(withdrawn[k]).playerId.empty() ? 0 : 1;
+    }
+    timer.stop();
+    suiteSink += removed;
+    drainPlayerQueue(queue);
+    return operations;
+}
+
+// The whole field registered in random order.
+long long suitePriorityQueueEnqueue(int fieldSize, SuiteTimer& timer) {
+    DynamicArray<Player> players;
+    makeTieredPlayers(fieldSize, players);
+    shufflePlayers(players, 1);
+    PriorityPlayerQueue queue;
+    timer.start();
+    for (int i = 0; i < players.size(); ++i) {
+        queue.enqueue(std::move(players[i]));
+    }
+    timer.stop();
+    suiteSink += queue.size();
+    return fieldSize;
+}
+
+// Seeding sort of a nearly ranked field (shuffled within blocks of 64, like a CSV that was
+// mostly kept in rank order); a fully shuffled 1M field would be quadratic.
+long long suiteInsertionSort(int fieldSize, SuiteTimer& timer) {
+    DynamicArray<Player> players;
+    makeSyntheticPlayers(fieldSize, players);
+    for (int block = 0; block < fieldSize; block += 64) {
+        int end = (block + 64 < fieldSize) ? block + 64 : fieldSize;
+        for (int i = end - 1; i > block; --i) {
+            int j = block + static_cast<int>(mixKey(i) % static_cast<unsigned long long>(i - block + 1));
+            swap(players[i], players[j]);
+        }
+    }
+    timer.start();
+    insertionSortPlayers(players.data(), players.size());
+    timer.stop();
+    suiteSink += players[0].ranking;
+    return fieldSize;
+}
+
+// Registration CSV of `fieldSize` rows in the repository's schema.
+long long suiteLoadPlayers(int fieldSize, SuiteTimer& timer) {
+    const string path = "tournament_suite_players.csv";
+    DynamicArray<Player> players;
+    makeTieredPlayers(fieldSize, players);
+    {
+        ofstream csv(path);
+        csv << "player_id,player_name,ranking,registration type\n";
+        for (int i = 0; i < players.size(); ++i) {
+            csv << players[i].playerId << ',' << players[i].playerName << ',' << players[i].ranking << ','
+                << players[i].originalPriority << '\n';
+        }
+    }
+    DiscardBuffer discard;
+    streambuf* console = cout.rdbuf(&discard); // The loader reports its total
+    {
+        TournamentRegistrationSystem registration;
+        timer.start();
+        registration.loadPlayersFromFile(path, fieldSize);
+        timer.stop();
+    }
+    cout.rdbuf(console);
+    remove(path.c_str());
+    return fieldSize;
+}
+
+// A scheduler holding the whole field, seeded, with its logger and outcome model.
+struct SuiteEvent {
+    GameResultLogger logger;
+    MatchOutcomeModel model;
+    MatchIdSequence matchIds;
+    SimulationLog log;
+    MatchScheduler scheduler;
+
+    SuiteEvent() : model(7), log(LogVerbosity::Silent, 4096), scheduler(logger, model, matchIds, log) {}
+
+    void addField(const DynamicArray<Player>& players) {
+        logger.reservePlayers(players.size());
+        for (int i = 0; i < players.size(); ++i) {
+            scheduler.addPlayer(players[i]);
+        }
+        scheduler.initializeTournament();
+    }
+
+    void playBracket() {
+        scheduler.advanceToNextRound();
+        while (!scheduler.isTournamentOver()) {
+            if (!scheduler.createNextRoundPairings()) {
+                break;
+            }
+            scheduler.playAndProcessMatches();
+            if (!scheduler.advanceToNextRound()) {
+                break;
+            }
+        }
+    }
+};
+
+// The championship group stage (16 groups drawn from the whole field by tier).
+long long suiteRunGroupStage(int fieldSize, SuiteTimer& timer) {
+    DynamicArray<Player> players;
+    makeTieredPlayers(fieldSize, players);
+    SuiteEvent event;
+    event.addField(players);
+    timer.start();
+    event.scheduler.runGroupStage(16);
+    timer.stop();
+    return fieldSize;
+}
+
+// Registration to champion with everyone playing: league groups of 4, the top 2 of each
+// into a single-elimination bracket. One operation is one match.
+long long suiteFullBracket(int fieldSize, SuiteTimer& timer) {
+    DynamicArray<Player> players;
+    makeTieredPlayers(fieldSize, players);
+    SuiteEvent event;
+    timer.start();
+    event.addField(players);
+    event.scheduler.runLeagueGroupStage(4, false, 2, 1);
+    event.playBracket();
+    timer.stop();
+    suiteSink += event.scheduler.getTournamentWinner().ranking;
+    return event.logger.getNumLoggedMatches();
+}
+
+// Results between random players of the field (building each Match included).
+long long suiteLoggerRecord(int fieldSize, SuiteTimer& timer) {
+    DynamicArray<Player> players;
+    makeSyntheticPlayers(fieldSize, players);
+    GameResultLogger logger;
+    logger.reservePlayers(fieldSize);
+    for (int i = 0; i < fieldSize; ++i) {
+        logger.initializePlayerForStats(players[i]);
+    }
+    timer.start();
+    for (int i = 0; i < fieldSize; ++i) {
+        int first = static_cast<int>(mixKey(i) % fieldSize);
+        int second = (first + 1 + static_cast<int>(mixKey(i + fieldSize) % (fieldSize - 1))) % fieldSize;
+        Match match(players[first], players[second], i + 1);
+        match.played = true;
+        match.winner = (mixKey(i) & 1) ? match.player1 : match.player2;
+        logger.recordMatchOutcome(match);
+    }
+    timer.stop();
+    return fieldSize;
+}
+
+// Profile queries after a season of one result per player: a random player's match rows
+// and their places by wins and by rating.
+long long suiteLoggerQueries(int fieldSize, SuiteTimer& timer) {
+    DynamicArray<Player> players;
+    makeSyntheticPlayers(fieldSize, players);
+    GameResultLogger logger;
+    logger.reservePlayers(fieldSize);
+    for (int i = 0; i < fieldSize; ++i) {
+        logger.initializePlayerForStats(players[i]);
+    }
+    for (int i = 0; i < fieldSize; ++i) {
+        int second = (i + 1 + static_cast<int>(mixKey(i) % (fieldSize - 1))) % fieldSize;
+        Match match(players[i], players[second], i + 1);
+        match.played = true;
+        match.winner = (mixKey(i) & 1) ? match.player1 : match.player2;
+        logger.recordMatchOutcome(match);
+    }
+    DynamicArray<int> rows;
+    long long found = 0;
+    timer.start();
+    for (int i = 0; i < fieldSize; ++i) {
+        const string& playerId = players[static_cast<int>(mixKey(i + 3) % fieldSize)].playerId;
+        found += logger.collectPlayerMatchRows(playerId, rows);
+        found += logger.getStanding(playerId, LeaderboardOrder::Wins);
+        found += logger.getStanding(playerId, LeaderboardOrder::Rating);
+    }
+    timer.stop();
+    suiteSink += found;
+    return fieldSize;
+}
+
+const int SUITE_UNLIMITED = 1 << 30;
+const SuiteCase SUITE_CASES[] = {
+    {"custom_queue", "enqueue or dequeue", SUITE_UNLIMITED, "", suiteCustomQueue},
+    {"custom_stack", "push or pop", SUITE_UNLIMITED, "", suiteCustomStack},
+    {"player_queue_insert_by_ranking", "insert into the full queue", SUITE_UNLIMITED, "", suitePlayerQueueInsert},
+    {"player_queue_remove_player", "remove by ID from the full queue", SUITE_UNLIMITED, "", suitePlayerQueueRemove},
+    {"priority_queue_enqueue", "enqueue", SUITE_UNLIMITED, "", suitePriorityQueueEnqueue},
+    {"insertion_sort_players", "player sorted", SUITE_UNLIMITED, "", suiteInsertionSort},
+    {"load_players_from_file", "CSV row", SUITE_UNLIMITED, "", suiteLoadPlayers},
+    {"run_group_stage", "player in the field", SUITE_UNLIMITED, "", suiteRunGroupStage},
+    {"full_bracket", "match", SUITE_UNLIMITED, "", suiteFullBracket},
+    {"logger_record_match", "result recorded", SUITE_UNLIMITED, "", suiteLoggerRecord},
+    {"logger_player_queries", "player profile query", SUITE_UNLIMITED, "", suiteLoggerQueries},
+};
+const int NUM_SUITE_CASES = sizeof(SUITE_CASES) / sizeof(SUITE_CASES[0]);
+
+void benchmarkEngineSuite() {
+    cout << "\n=== Engine suite: " << NUM_SUITE_CASES << " cases at field sizes 64, 10k, 1M ===" << endl;
+    ofstream json(suiteJsonPath);
+    if (!json.is_open()) {
+        cerr << "Error: Unable to write " << suiteJsonPath << "." << endl;
+        return;
+    }
+    json << "{\n  \"suite\": \"tournament-engine\",\n  \"schema_version\": 1,\n"
+         << "  \"timestamp\": " << time(nullptr) << ",\n"
+#ifdef __VERSION__
+         << "  \"compiler\": \"" << __VERSION__ << "\",\n"
+#endif
+#ifdef __OPTIMIZE__
+         << "  \"optimized\": true,\n"
+#else
+         << "  \"optimized\": false,\n"
+#endif
+         << "  \"min_timed_ms\": " << SUITE_MIN_MS << ",\n  \"results\": [";
+
+    bool first = true;
+    for (int c = 0; c < NUM_SUITE_CASES; ++c) {
+        const SuiteCase& suiteCase = SUITE_CASES[c];
+        for (int s = 0; s < NUM_SUITE_FIELD_SIZES; ++s) {
+            int fieldSize = SUITE_FIELD_SIZES[s];
+            json << (first ? "\n" : ",\n") << "    {\"name\": \"" << suiteCase.name << "\", \"field_size\": " << fieldSize;
+            first = false;
+            cout << left << setw(32) << suiteCase.name << right << setw(8) << fieldSize << "  ";
+            if (fieldSize > suiteCase.maxFieldSize) {
+                json << ", \"skipped\": \"" << suiteCase.skipReason << "\"}";
+                cout << "skipped" << endl;
+                continue;
+            }
+
+            SuiteTimer timer;
+            long long operations = 0;
+            int repetitions = 0;
+            while (repetitions < SUITE_MAX_REPETITIONS && (repetitions == 0 || timer.milliseconds < SUITE_MIN_MS)) {
+                operations += suiteCase.run(fieldSize, timer);
+                repetitions++;
+            }
+            double nsPerOperation = timer.milliseconds * 1e6 / static_cast<double>(operations);
+            double allocationsPerOperation = static_cast<double>(timer.allocations) / static_cast<double>(operations);
+            json << ", \"operation\": \"" << suiteCase.operation << "\", \"repetitions\": " << repetitions
+                 << ", \"operations\": " << operations << ", \"timed_ms\": " << timer.milliseconds
+                 << ", \"ns_per_op\": " << nsPerOperation << ", \"ops_per_sec\": " << (1e9 / nsPerOperation)
+                 << ", \"allocations_per_op\": " << allocationsPerOperation << "}";
+            cout << fixed << setprecision(1) << setw(12) << nsPerOperation << " ns/op  " << setprecision(2)
+                 << setw(8) << allocationsPerOperation << " allocs/op  (" << suiteCase.operation << ")" << endl;
+            cout.unsetf(ios::fixed);
+            cout << setprecision(6);
+        }
+    }
+    json << "\n  ]\n}\n";
+    cout << "Results written to " << suiteJsonPath << endl;
+}
+
+// --- Driver ---
+struct BenchmarkEntry {
+    const char* name;
+    void (*run)();
+};
+
+const BenchmarkEntry BENCHMARKS[] = {
+    {"event-bracket", benchmarkEventDrivenBracket},
+    {"bracket-corrections", benchmarkBracketCorrections},
+    {"stats-index", benchmarkStatsIndex},
+    {"player-index", benchmarkPlayerMatchIndex},
+    {"columnar-log", benchmarkColumnarLog},
+    {"history-file", benchmarkHistoryFile},
+    {"match-queries", benchmarkMatchQueries},
+    {"leaderboard", benchmarkLeaderboard},
+    {"season-ratings", benchmarkSeasonRatings},
+    {"concurrent-recording", benchmarkConcurrentRecording},
+    {"report-allocations", benchmarkReportAllocations},
+    {"ring-queue", benchmarkRingBufferQueue},
+    {"player-flow", benchmarkPlayerFlow},
+    {"player-keys", benchmarkPlayerKeys},
+    {"suite", benchmarkEngineSuite},
+};
+const int NUM_BENCHMARKS = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+
+int main(int argc, char* argv[]) {
+    int namedBenchmarks = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--json" && i + 1 < argc) {
+            suiteJsonPath = argv[++i];
+        } else {
+            namedBenchmarks++;
+        }
+    }
+    for (int b = 0; b < NUM_BENCHMARKS; ++b) {
+        bool selected = (namedBenchmarks == 0);
+        for (int i = 1; i < argc; ++i) {
+            if (string(argv[i]) == "--json") {
+                i++;
+            } else if (string(argv[i]) == BENCHMARKS[b].name) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            BENCHMARKS[b].run();
+        }
+    }
+    return 0;
+}